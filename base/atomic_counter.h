@@ -0,0 +1,92 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MINI_CHROMIUM_BASE_ATOMIC_COUNTER_H_
+#define MINI_CHROMIUM_BASE_ATOMIC_COUNTER_H_
+
+#include <atomic>
+#include <type_traits>
+
+namespace base {
+
+// A typed atomic integer for counters, sequence numbers and similar values
+// that are updated concurrently. This replaces base::subtle::Atomic32/Atomic64
+// with the NoBarrier_AtomicIncrement() and Barrier_AtomicIncrement() routines
+// from base/atomicops.h: the storage is a real std::atomic<T> rather than a
+// volatile integer reinterpreted as one, and every operation names its memory
+// order instead of choosing between "none" and "full barrier".
+//
+// All operations default to std::memory_order_relaxed, which is correct for
+// statistics and for allocating unique values. Pass a stronger order only when
+// the counter is used to publish other memory.
+//
+// A heavily-written counter shared between cores should be wrapped in
+// CacheLinePadded (base/memory/cache_line_padded.h).
+template <typename T>
+class AtomicCounter {
+ public:
+  static_assert(std::is_integral_v<T>, "AtomicCounter requires an integer");
+
+  constexpr AtomicCounter() : value_(0) {}
+  explicit constexpr AtomicCounter(T initial_value) : value_(initial_value) {}
+
+  AtomicCounter(const AtomicCounter&) = delete;
+  AtomicCounter& operator=(const AtomicCounter&) = delete;
+
+  // Adds |delta| and returns the new value, matching the convention of
+  // NoBarrier_AtomicIncrement().
+  T Increment(T delta = 1,
+              std::memory_order order = std::memory_order_relaxed) {
+    T previous = value_.fetch_add(delta, order);
+    return static_cast<T>(static_cast<Unsigned>(previous) +
+                          static_cast<Unsigned>(delta));
+  }
+
+  // Subtracts |delta| and returns the new value.
+  T Decrement(T delta = 1,
+              std::memory_order order = std::memory_order_relaxed) {
+    T previous = value_.fetch_sub(delta, order);
+    return static_cast<T>(static_cast<Unsigned>(previous) -
+                          static_cast<Unsigned>(delta));
+  }
+
+  // Adds |delta| and returns the previous value. Use for handing out indices
+  // or sequence numbers.
+  T FetchAdd(T delta, std::memory_order order = std::memory_order_relaxed) {
+    return value_.fetch_add(delta, order);
+  }
+
+  T Load(std::memory_order order = std::memory_order_relaxed) const {
+    return value_.load(order);
+  }
+
+  void Store(T value, std::memory_order order = std::memory_order_relaxed) {
+    value_.store(value, order);
+  }
+
+  T Exchange(T value, std::memory_order order = std::memory_order_relaxed) {
+    return value_.exchange(value, order);
+  }
+
+  // If the counter holds |*expected|, replaces it with |desired| and returns
+  // true. Otherwise stores the current value in |*expected| and returns
+  // false. The failure order is derived from |order| as by std::atomic.
+  bool CompareExchange(T* expected,
+                       T desired,
+                       std::memory_order order = std::memory_order_relaxed) {
+    return value_.compare_exchange_strong(*expected, desired, order);
+  }
+
+ private:
+  // Increment() and Decrement() compute the new value in the unsigned type,
+  // so that it wraps around as the stored value does, where signed overflow
+  // would be undefined.
+  using Unsigned = std::make_unsigned_t<T>;
+
+  std::atomic<T> value_;
+};
+
+}  // namespace base
+
+#endif  // MINI_CHROMIUM_BASE_ATOMIC_COUNTER_H_
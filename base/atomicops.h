@@ -2,8 +2,16 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
-// For atomic operations on reference counts, see atomic_refcount.h.
-// For atomic operations on sequence numbers, see atomic_sequence_num.h.
+// For atomic operations on reference counts, see atomic_ref_count.h.
+// For counters and sequence numbers, see atomic_counter.h.
+// For one-shot flags, see synchronization/atomic_flag.h.
+//
+// New code should prefer those typed wrappers, or std::atomic<> with an
+// explicit memory order, over the routines in this file. The routines here
+// operate on volatile integers, which defeats optimization around them, and
+// offer only a fixed menu of orderings, some of which (Acquire_Store() and
+// Release_Load()) do not exist in the C++ memory model and are emulated with
+// full fences.
 
 // The routines exported by this module are subtle.  If you use them, even if
 // you get the code right, it will depend on careful reasoning about atomicity
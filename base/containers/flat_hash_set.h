@@ -0,0 +1,85 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MINI_CHROMIUM_BASE_CONTAINERS_FLAT_HASH_SET_H_
+#define MINI_CHROMIUM_BASE_CONTAINERS_FLAT_HASH_SET_H_
+
+#include <stddef.h>
+
+#include <initializer_list>
+#include <utility>
+
+#include "base/containers/raw_hash_table_internal.h"
+
+namespace base {
+
+// flat_hash_set<Key> is an unordered set that stores its elements in one flat
+// array, in the style of Abseil's SwissTable; see flat_hash_map for details.
+// It supports the common subset of the std::unordered_set interface, except
+// that erase(iterator) returns nothing.
+//
+// Inserting or erasing invalidates iterators and references, since elements
+// move when the table grows. Iteration order is unspecified; it is not
+// insertion order, and differs between sets with the same elements.
+//
+//   base::flat_hash_set<std::string> names = {"a", "b"};
+//   if (names.contains(base::StringPiece("a"))) { ... }
+template <typename Key,
+          typename Hash = FlatHashDefaultHash<Key>,
+          typename Eq = FlatHashDefaultEq<Key>>
+class flat_hash_set
+    : public internal::RawHashTable<internal::FlatHashSetPolicy<Key>,
+                                    Hash,
+                                    Eq> {
+  using Base =
+      internal::RawHashTable<internal::FlatHashSetPolicy<Key>, Hash, Eq>;
+
+ public:
+  using typename Base::iterator;
+  using typename Base::key_type;
+
+  using Base::Base;
+
+  flat_hash_set() = default;
+
+  flat_hash_set(std::initializer_list<Key> values) {
+    this->reserve(values.size());
+    for (const Key& value : values) {
+      insert(value);
+    }
+  }
+
+  // Inserts `value` if no element is equal to it. Returns an iterator to the
+  // element equal to `value`, and whether it was inserted.
+  std::pair<iterator, bool> insert(const Key& value) { return emplace(value); }
+  std::pair<iterator, bool> insert(Key&& value) {
+    return emplace(std::move(value));
+  }
+
+  // Constructs an element from `args` and inserts it if no element is equal
+  // to it.
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    if constexpr (sizeof...(Args) == 1 &&
+                  (std::is_same_v<std::remove_cvref_t<Args>, Key> && ...)) {
+      return EmplaceKey(std::forward<Args>(args)...);
+    } else {
+      return EmplaceKey(Key(std::forward<Args>(args)...));
+    }
+  }
+
+ private:
+  template <typename K>
+  std::pair<iterator, bool> EmplaceKey(K&& key) {
+    // `key` may be an element, so it is used before any element moves.
+    auto [slot, inserted] = this->FindOrConstruct(key, [&](auto* new_slot) {
+      std::construct_at(new_slot, std::forward<K>(key));
+    });
+    return {this->IteratorFor(slot), inserted};
+  }
+};
+
+}  // namespace base
+
+#endif  // MINI_CHROMIUM_BASE_CONTAINERS_FLAT_HASH_SET_H_
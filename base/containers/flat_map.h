@@ -0,0 +1,158 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MINI_CHROMIUM_BASE_CONTAINERS_FLAT_MAP_H_
+#define MINI_CHROMIUM_BASE_CONTAINERS_FLAT_MAP_H_
+
+#include <functional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "base/check.h"
+#include "base/containers/flat_tree.h"
+
+namespace base {
+
+namespace internal {
+
+struct GetFirst {
+  template <typename Key, typename Mapped>
+  const Key& operator()(const std::pair<Key, Mapped>& value) const {
+    return value.first;
+  }
+};
+
+// The methods that flat_map and eytzinger_flat_map add to flat_tree.
+template <typename Key,
+          typename Mapped,
+          typename Compare,
+          typename Container,
+          FlatTreeSearch kSearch>
+class flat_map_impl : public flat_tree<Key,
+                                       std::pair<Key, Mapped>,
+                                       GetFirst,
+                                       Compare,
+                                       Container,
+                                       kSearch> {
+  using Tree =
+      flat_tree<Key, std::pair<Key, Mapped>, GetFirst, Compare, Container,
+                kSearch>;
+
+ public:
+  using typename Tree::iterator;
+  using mapped_type = Mapped;
+
+  using Tree::Tree;
+  using Tree::operator=;
+
+  // Returns the value for `key`, inserting a value-initialized one if there
+  // is none.
+  Mapped& operator[](const Key& key) ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    return try_emplace(key).first->second;
+  }
+  Mapped& operator[](Key&& key) ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    return try_emplace(std::move(key)).first->second;
+  }
+
+  // Returns the value for `key`, which must be present.
+  template <typename K>
+  Mapped& at(const K& key) ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    auto it = this->find(key);
+    CHECK(it != this->end());
+    return it->second;
+  }
+  template <typename K>
+  const Mapped& at(const K& key) const ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    auto it = this->find(key);
+    CHECK(it != this->end());
+    return it->second;
+  }
+
+  // Inserts an element from `key` and `args` if there is no element with
+  // `key`, and otherwise does nothing, leaving `args` untouched.
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+    iterator it = this->lower_bound(key);
+    if (it != this->end() && !this->comp()(key, it->first)) {
+      return {it, false};
+    }
+    it = this->InsertAt(it, [&] {
+      return std::pair<Key, Mapped>(
+          std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+          std::forward_as_tuple(std::forward<Args>(args)...));
+    });
+    return {it, true};
+  }
+
+  // Inserts an element from `key` and `value`, or assigns `value` to the
+  // element with `key`.
+  template <typename K, typename V>
+  std::pair<iterator, bool> insert_or_assign(K&& key, V&& value) {
+    auto result = try_emplace(std::forward<K>(key), std::forward<V>(value));
+    if (!result.second) {
+      result.first->second = std::forward<V>(value);
+    }
+    return result;
+  }
+};
+
+}  // namespace internal
+
+// flat_map<Key, Mapped> is a map stored as a vector of pairs sorted by key.
+// It is meant for maps that are built once and then searched many times,
+// especially small ones: lookups are a binary search of contiguous memory,
+// and iteration is a walk over an array. Each insertion or erasure moves the
+// elements after it, so build a map from a vector of its elements, which are
+// sorted and deduplicated once, rather than inserting them one by one.
+//
+// Lookups take any type that `Compare` can compare with Key; the default,
+// std::less<>, allows looking up std::string keys by std::string_view, for
+// example. The binary search is branchless; maps too large to fit in cache
+// can use eytzinger_flat_map instead.
+//
+// The elements are contiguous, so a map converts to
+// span<const std::pair<Key, Mapped>>, and range() returns the span of
+// elements with keys in a given interval:
+//
+//   base::flat_map<int, std::string> ports(std::move(port_name_pairs));
+//   for (const auto& [port, name] : ports.range(1024, 49152)) { ... }
+//
+// Any modification invalidates iterators and spans. Do not modify keys
+// through iterators, which would break the order.
+template <typename Key,
+          typename Mapped,
+          typename Compare = std::less<>,
+          typename Container = std::vector<std::pair<Key, Mapped>>>
+class flat_map : public internal::flat_map_impl<
+                     Key,
+                     Mapped,
+                     Compare,
+                     Container,
+                     internal::FlatTreeSearch::kBinary> {
+ public:
+  using flat_map::flat_map_impl::flat_map_impl;
+  using flat_map::flat_map_impl::operator=;
+};
+
+// eytzinger_flat_map<Key, Mapped> is a flat_map for maps too large to fit in
+// cache. See eytzinger_flat_set.
+template <typename Key,
+          typename Mapped,
+          typename Compare = std::less<>,
+          typename Container = std::vector<std::pair<Key, Mapped>>>
+class eytzinger_flat_map : public internal::flat_map_impl<
+                               Key,
+                               Mapped,
+                               Compare,
+                               Container,
+                               internal::FlatTreeSearch::kEytzinger> {
+ public:
+  using eytzinger_flat_map::flat_map_impl::flat_map_impl;
+  using eytzinger_flat_map::flat_map_impl::operator=;
+};
+
+}  // namespace base
+
+#endif  // MINI_CHROMIUM_BASE_CONTAINERS_FLAT_MAP_H_
@@ -0,0 +1,62 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MINI_CHROMIUM_BASE_CONTAINERS_FLAT_SET_H_
+#define MINI_CHROMIUM_BASE_CONTAINERS_FLAT_SET_H_
+
+#include <functional>
+#include <vector>
+
+#include "base/containers/flat_tree.h"
+
+namespace base {
+
+namespace internal {
+
+struct GetKeyFromValueIdentity {
+  template <typename T>
+  const T& operator()(const T& value) const {
+    return value;
+  }
+};
+
+}  // namespace internal
+
+// flat_set<Key> is a set stored as a sorted vector, for sets that are built
+// once and then searched many times. See flat_map for details; the same
+// trade-offs apply.
+//
+//   const base::flat_set<std::string> kAllowedSchemes({"http", "https"});
+//   if (kAllowedSchemes.contains(std::string_view(scheme))) { ... }
+//
+// Do not modify elements through iterators, which would break the order.
+template <typename Key,
+          typename Compare = std::less<>,
+          typename Container = std::vector<Key>>
+using flat_set = internal::flat_tree<Key,
+                                     Key,
+                                     internal::GetKeyFromValueIdentity,
+                                     Compare,
+                                     Container,
+                                     internal::FlatTreeSearch::kBinary>;
+
+// eytzinger_flat_set<Key> is a flat_set for sets too large to fit in cache,
+// such as a million 8-byte keys, where its lookups take two thirds of the
+// time of flat_set's. It keeps a second copy of the keys, laid out so that a
+// lookup can prefetch the next few steps of its search, and rebuilds that
+// copy on every modification. Below around 100,000 keys, flat_set is faster.
+template <typename Key,
+          typename Compare = std::less<>,
+          typename Container = std::vector<Key>>
+using eytzinger_flat_set =
+    internal::flat_tree<Key,
+                        Key,
+                        internal::GetKeyFromValueIdentity,
+                        Compare,
+                        Container,
+                        internal::FlatTreeSearch::kEytzinger>;
+
+}  // namespace base
+
+#endif  // MINI_CHROMIUM_BASE_CONTAINERS_FLAT_SET_H_
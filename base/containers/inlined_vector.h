@@ -0,0 +1,453 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MINI_CHROMIUM_BASE_CONTAINERS_INLINED_VECTOR_H_
+#define MINI_CHROMIUM_BASE_CONTAINERS_INLINED_VECTOR_H_
+
+#include <stddef.h>
+#include <string.h>
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "base/check.h"
+#include "base/check_op.h"
+#include "base/compiler_specific.h"
+#include "base/containers/checked_iterators.h"
+#include "base/containers/span.h"
+
+// No absl in mini_chromium
+#if !defined(ABSL_ATTRIBUTE_LIFETIME_BOUND)
+#define ABSL_ATTRIBUTE_LIFETIME_BOUND
+#endif
+
+namespace base {
+
+// InlinedVector<T, N> is a vector that stores up to N elements inside itself
+// and only allocates heap storage once it grows beyond that. Use it for small
+// collections that are usually short, such as argument lists, path
+// components or header fields, where std::vector would allocate every time.
+//
+// It supports the common subset of the std::vector interface. Like span and
+// HeapArray, it CHECKs indexing, and its iterators are
+// CheckedContiguousIterators when DCHECKs are on (and raw pointers
+// otherwise). It converts implicitly to span<T>:
+//
+//   void ProcessComponents(base::span<const std::string_view> components);
+//
+//   base::InlinedVector<std::string_view, 8> components;
+//   for (std::string_view component : SplitPath(path)) {
+//     components.push_back(component);
+//   }
+//   ProcessComponents(components);
+//
+// Moving an InlinedVector whose elements are on the heap steals the heap
+// storage, leaving the source empty. Moving one whose elements are inline
+// moves them one by one, so it costs as much as moving N elements of T, and
+// inline elements are not stable across a move or swap.
+template <typename T, size_t N>
+class InlinedVector {
+ public:
+  static_assert(N > 0, "Use std::vector for no inline capacity");
+  static_assert(!std::is_const_v<T>, "InlinedVector cannot hold const types");
+  static_assert(!std::is_reference_v<T>,
+                "InlinedVector cannot hold reference types");
+
+  using value_type = T;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using const_pointer = const T*;
+#if DCHECK_IS_ON()
+  using iterator = CheckedContiguousIterator<T>;
+  using const_iterator = CheckedContiguousIterator<const T>;
+#else
+  using iterator = T*;
+  using const_iterator = const T*;
+#endif
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  static constexpr size_t inline_capacity() { return N; }
+
+  InlinedVector() = default;
+
+  // Constructs `count` value-initialized (i.e. zeroed for primitive types)
+  // elements.
+  explicit InlinedVector(size_t count) { resize(count); }
+
+  InlinedVector(size_t count, const T& value) { resize(count, value); }
+
+  InlinedVector(std::initializer_list<T> values) {
+    AppendCopies(values.begin(), values.size());
+  }
+
+  explicit InlinedVector(span<const T> values) {
+    AppendCopies(values.data(), values.size());
+  }
+
+  InlinedVector(const InlinedVector& other) {
+    AppendCopies(other.data_, other.size_);
+  }
+
+  // Steals `other`'s heap storage if it has any, and otherwise moves its
+  // elements. Leaves `other` empty.
+  InlinedVector(InlinedVector&& other) noexcept { MoveFrom(other); }
+
+  InlinedVector& operator=(const InlinedVector& other) {
+    if (this != &other) {
+      clear();
+      AppendCopies(other.data_, other.size_);
+    }
+    return *this;
+  }
+
+  // Leaves `other` empty.
+  InlinedVector& operator=(InlinedVector&& other) noexcept {
+    if (this != &other) {
+      clear();
+      FreeHeapStorage();
+      MoveFrom(other);
+    }
+    return *this;
+  }
+
+  ~InlinedVector() {
+    clear();
+    FreeHeapStorage();
+  }
+
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+  size_t capacity() const { return capacity_; }
+
+  // Returns true if the elements are stored inside the vector rather than on
+  // the heap.
+  bool is_inline() const { return data_ == inline_data(); }
+
+  T* data() ABSL_ATTRIBUTE_LIFETIME_BOUND { return data_; }
+  const T* data() const ABSL_ATTRIBUTE_LIFETIME_BOUND { return data_; }
+
+  T& operator[](size_t index) ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    CHECK_LT(index, size_);
+    // SAFETY: `index` is in bounds, checked above.
+    return UNSAFE_BUFFERS(data_[index]);
+  }
+  const T& operator[](size_t index) const ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    CHECK_LT(index, size_);
+    // SAFETY: `index` is in bounds, checked above.
+    return UNSAFE_BUFFERS(data_[index]);
+  }
+
+  T& front() ABSL_ATTRIBUTE_LIFETIME_BOUND { return (*this)[0]; }
+  const T& front() const ABSL_ATTRIBUTE_LIFETIME_BOUND { return (*this)[0]; }
+  T& back() ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    CHECK(!empty());
+    return (*this)[size_ - 1];
+  }
+  const T& back() const ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    CHECK(!empty());
+    return (*this)[size_ - 1];
+  }
+
+  iterator begin() ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    return MakeIterator<iterator>(data_, size_, 0);
+  }
+  const_iterator begin() const ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    return MakeIterator<const_iterator>(data_, size_, 0);
+  }
+  const_iterator cbegin() const ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    return begin();
+  }
+
+  iterator end() ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    return MakeIterator<iterator>(data_, size_, size_);
+  }
+  const_iterator end() const ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    return MakeIterator<const_iterator>(data_, size_, size_);
+  }
+  const_iterator cend() const ABSL_ATTRIBUTE_LIFETIME_BOUND { return end(); }
+
+  reverse_iterator rbegin() ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    return reverse_iterator(end());
+  }
+  const_reverse_iterator rbegin() const ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    return const_reverse_iterator(end());
+  }
+  reverse_iterator rend() ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    return reverse_iterator(begin());
+  }
+  const_reverse_iterator rend() const ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    return const_reverse_iterator(begin());
+  }
+
+  base::span<T> as_span() ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    // SAFETY: `data_` points to `size_` elements.
+    return UNSAFE_BUFFERS(base::span<T>(data_, size_));
+  }
+  base::span<const T> as_span() const ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    // SAFETY: `data_` points to `size_` elements.
+    return UNSAFE_BUFFERS(base::span<const T>(data_, size_));
+  }
+
+  // Ensures that the vector can hold `new_capacity` elements without
+  // reallocating.
+  void reserve(size_t new_capacity) {
+    if (new_capacity > capacity_) {
+      Reallocate(new_capacity);
+    }
+  }
+
+  // Moves the elements back inline if they fit, and otherwise shrinks the
+  // heap storage to fit them.
+  void shrink_to_fit() {
+    if (is_inline() || size_ == capacity_) {
+      return;
+    }
+    T* heap_data = data_;
+    size_t heap_capacity = capacity_;
+    if (size_ <= N) {
+      data_ = inline_data();
+      capacity_ = N;
+    } else {
+      data_ = AllocateHeapStorage(size_);
+      capacity_ = size_;
+    }
+    Relocate(heap_data, size_, data_);
+    std::allocator<T>().deallocate(heap_data, heap_capacity);
+  }
+
+  // Destroys all elements. Keeps any heap storage.
+  void clear() {
+    std::destroy_n(data_, size_);
+    size_ = 0;
+  }
+
+  void push_back(const T& value) { emplace_back(value); }
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+
+  template <typename... Args>
+  T& emplace_back(Args&&... args) ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    if (size_ == capacity_) [[unlikely]] {
+      return GrowAndEmplaceBack(std::forward<Args>(args)...);
+    }
+    T* element = std::construct_at(end_ptr(), std::forward<Args>(args)...);
+    ++size_;
+    return *element;
+  }
+
+  void pop_back() {
+    CHECK(!empty());
+    --size_;
+    std::destroy_at(end_ptr());
+  }
+
+  // Inserts an element before `position`, and returns an iterator to it.
+  iterator insert(const_iterator position, const T& value)
+      ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    return emplace(position, value);
+  }
+  iterator insert(const_iterator position, T&& value)
+      ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    return emplace(position, std::move(value));
+  }
+
+  template <typename... Args>
+  iterator emplace(const_iterator position, Args&&... args)
+      ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    size_t index = IndexOf(position);
+    emplace_back(std::forward<Args>(args)...);
+    std::rotate(begin() + index, end() - 1, end());
+    return begin() + index;
+  }
+
+  // Removes the element at `position`, and returns an iterator to the element
+  // that followed it.
+  iterator erase(const_iterator position) ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    size_t index = IndexOf(position);
+    CHECK_LT(index, size_);
+    return erase(position, position + 1);
+  }
+
+  // Removes the elements in [first, last), and returns an iterator to the
+  // element that followed them.
+  iterator erase(const_iterator first, const_iterator last)
+      ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    size_t index = IndexOf(first);
+    size_t end_index = IndexOf(last);
+    CHECK_LE(index, end_index);
+    iterator new_end =
+        std::move(begin() + end_index, end(), begin() + index);
+    size_t new_size = static_cast<size_t>(new_end - begin());
+    std::destroy(new_end, end());
+    size_ = new_size;
+    return begin() + index;
+  }
+
+  // Resizes to `new_size` elements, value-initializing any new ones.
+  void resize(size_t new_size) {
+    if (new_size <= size_) {
+      Truncate(new_size);
+      return;
+    }
+    Grow(new_size);
+    std::uninitialized_value_construct_n(end_ptr(), new_size - size_);
+    size_ = new_size;
+  }
+
+  // Resizes to `new_size` elements, copying `value` into any new ones.
+  void resize(size_t new_size, const T& value) {
+    if (new_size <= size_) {
+      Truncate(new_size);
+      return;
+    }
+    if (new_size > capacity_) {
+      // `value` may be an element, which reallocating would destroy.
+      T copy(value);
+      Grow(new_size);
+      std::uninitialized_fill_n(end_ptr(), new_size - size_, copy);
+    } else {
+      std::uninitialized_fill_n(end_ptr(), new_size - size_, value);
+    }
+    size_ = new_size;
+  }
+
+  friend bool operator==(const InlinedVector& lhs, const InlinedVector& rhs) {
+    return std::ranges::equal(lhs.as_span(), rhs.as_span());
+  }
+
+ private:
+  T* inline_data() { return reinterpret_cast<T*>(inline_storage_); }
+  const T* inline_data() const {
+    return reinterpret_cast<const T*>(inline_storage_);
+  }
+
+  T* end_ptr() {
+    // SAFETY: `data_` points to storage for `capacity_` >= `size_` elements.
+    return UNSAFE_BUFFERS(data_ + size_);
+  }
+
+  // Returns an iterator to element `index` of the `size` elements at `data`.
+  template <typename It, typename Ptr>
+  static It MakeIterator(Ptr data, size_t size, size_t index) {
+#if DCHECK_IS_ON()
+    // SAFETY: `data` points to `size` elements, and `index` <= `size`.
+    return UNSAFE_BUFFERS(It(data, data + index, data + size));
+#else
+    // SAFETY: `data` points to `size` elements, and `index` <= `size`.
+    return UNSAFE_BUFFERS(data + index);
+#endif
+  }
+
+  size_t IndexOf(const_iterator position) const {
+    ptrdiff_t index = position - begin();
+    CHECK_GE(index, 0);
+    CHECK_LE(static_cast<size_t>(index), size_);
+    return static_cast<size_t>(index);
+  }
+
+  void Truncate(size_t new_size) {
+    // SAFETY: `new_size` <= `size_`.
+    std::destroy_n(UNSAFE_BUFFERS(data_ + new_size), size_ - new_size);
+    size_ = new_size;
+  }
+
+  void AppendCopies(const T* values, size_t count) {
+    Grow(size_ + count);
+    std::uninitialized_copy_n(values, count, end_ptr());
+    size_ += count;
+  }
+
+  // Moves `count` elements from `from` to the uninitialized storage at `to`,
+  // and destroys the originals.
+  static void Relocate(T* from, size_t count, T* to) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      if (count) {
+        memcpy(to, from, count * sizeof(T));
+      }
+    } else {
+      std::uninitialized_move_n(from, count, to);
+      std::destroy_n(from, count);
+    }
+  }
+
+  // Returns the capacity to grow to for `min_capacity` elements. Capacity at
+  // least doubles, so that appending takes amortized constant time.
+  size_t GrownCapacity(size_t min_capacity) const {
+    return std::max(min_capacity, capacity_ * 2);
+  }
+
+  // Ensures room for `min_capacity` elements, growing geometrically.
+  void Grow(size_t min_capacity) {
+    if (min_capacity > capacity_) {
+      Reallocate(GrownCapacity(min_capacity));
+    }
+  }
+
+  static T* AllocateHeapStorage(size_t capacity) {
+    CHECK_LE(capacity, std::allocator_traits<std::allocator<T>>::max_size(
+                           std::allocator<T>()));
+    return std::allocator<T>().allocate(capacity);
+  }
+
+  // Moves the elements to new heap storage for `new_capacity` elements.
+  void Reallocate(size_t new_capacity) {
+    T* new_data = AllocateHeapStorage(new_capacity);
+    Relocate(data_, size_, new_data);
+    FreeHeapStorage();
+    data_ = new_data;
+    capacity_ = new_capacity;
+  }
+
+  // Constructs the new element before moving the old ones, as `args` may
+  // refer to them.
+  template <typename... Args>
+  NOINLINE T& GrowAndEmplaceBack(Args&&... args) {
+    size_t new_capacity = GrownCapacity(size_ + 1);
+    T* new_data = AllocateHeapStorage(new_capacity);
+    // SAFETY: `new_data` has room for `new_capacity` > `size_` elements.
+    T* element = std::construct_at(UNSAFE_BUFFERS(new_data + size_),
+                                   std::forward<Args>(args)...);
+    Relocate(data_, size_, new_data);
+    FreeHeapStorage();
+    data_ = new_data;
+    capacity_ = new_capacity;
+    ++size_;
+    return *element;
+  }
+
+  void FreeHeapStorage() {
+    if (!is_inline()) {
+      std::allocator<T>().deallocate(data_, capacity_);
+      data_ = inline_data();
+      capacity_ = N;
+    }
+  }
+
+  // Requires this vector to be empty and inline.
+  void MoveFrom(InlinedVector& other) {
+    if (other.is_inline()) {
+      Relocate(other.data_, other.size_, data_);
+    } else {
+      data_ = std::exchange(other.data_, other.inline_data());
+      capacity_ = std::exchange(other.capacity_, N);
+    }
+    size_ = std::exchange(other.size_, 0u);
+  }
+
+  T* data_ = inline_data();
+  size_t size_ = 0;
+  size_t capacity_ = N;
+  alignas(T) unsigned char inline_storage_[N * sizeof(T)];
+};
+
+}  // namespace base
+
+#endif  // MINI_CHROMIUM_BASE_CONTAINERS_INLINED_VECTOR_H_
@@ -0,0 +1,857 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MINI_CHROMIUM_BASE_CONTAINERS_RAW_HASH_TABLE_INTERNAL_H_
+#define MINI_CHROMIUM_BASE_CONTAINERS_RAW_HASH_TABLE_INTERNAL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "base/check.h"
+#include "base/check_op.h"
+#include "base/compiler_specific.h"
+#include "base/strings/string_piece.h"
+#include "build/build_config.h"
+
+#if defined(ARCH_CPU_X86_FAMILY) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace base {
+
+namespace internal {
+
+inline std::string_view ToStringView(std::string_view value) {
+  return value;
+}
+inline std::string_view ToStringView(const std::string& value) {
+  return value;
+}
+inline std::string_view ToStringView(const char* value) {
+  return value;
+}
+inline std::string_view ToStringView(const StringPiece& value) {
+  return std::string_view(value.data(), value.size());
+}
+
+// Hashes and compares std::string, std::string_view, StringPiece and C
+// strings interchangeably, so that tables keyed by std::string can be
+// searched without constructing one.
+struct StringHash {
+  using is_transparent = void;
+
+  template <typename S>
+  size_t operator()(const S& value) const {
+    return std::hash<std::string_view>()(ToStringView(value));
+  }
+};
+
+struct StringEq {
+  using is_transparent = void;
+
+  template <typename S1, typename S2>
+  bool operator()(const S1& lhs, const S2& rhs) const {
+    return ToStringView(lhs) == ToStringView(rhs);
+  }
+};
+
+}  // namespace internal
+
+// The default hash and equality functors of flat_hash_map and flat_hash_set.
+// They are std::hash and std::equal_to, except for string keys, which can be
+// looked up by any string type (see internal::StringHash).
+template <typename T>
+struct FlatHashDefaultHash : std::hash<T> {};
+template <>
+struct FlatHashDefaultHash<std::string> : internal::StringHash {};
+template <>
+struct FlatHashDefaultHash<std::string_view> : internal::StringHash {};
+template <>
+struct FlatHashDefaultHash<StringPiece> : internal::StringHash {};
+
+template <typename T>
+struct FlatHashDefaultEq : std::equal_to<T> {};
+template <>
+struct FlatHashDefaultEq<std::string> : internal::StringEq {};
+template <>
+struct FlatHashDefaultEq<std::string_view> : internal::StringEq {};
+template <>
+struct FlatHashDefaultEq<StringPiece> : internal::StringEq {};
+
+namespace internal {
+
+// The implementation of flat_hash_map and flat_hash_set: an open-addressing
+// hash table in the style of Abseil's SwissTable.
+//
+// Each slot has a control byte, kept in an array of its own. The control byte
+// of a full slot holds the low 7 bits of its element's hash (H2); the other
+// control bytes mark empty and deleted slots, and a sentinel marks the end of
+// the array. A lookup starts at a position given by the rest of the hash
+// (H1) and examines a Group of 8 or 16 consecutive control bytes at a time:
+// one SIMD compare finds the slots whose H2 matches, which are the only ones
+// whose keys need comparing, and another finds whether the group has an
+// empty slot, which ends the search. Groups are probed in a triangular
+// sequence, which visits every group when the capacity is a power of two.
+//
+// The capacity is always one less than a power of two. The first
+// Group::kWidth - 1 control bytes are cloned after the sentinel, so that a
+// group can be loaded from any position without wrapping around.
+//
+// The table holds at most 7/8 of its capacity, and grows by doubling. Erasing
+// marks a slot deleted, unless no probe sequence could have passed over it,
+// in which case it is marked empty again. Deleted slots are reused by
+// insertions, and dropped when the table is rehashed.
+
+// Control bytes. Their values are chosen so that Group can classify them with
+// bit tricks.
+using ctrl_t = int8_t;
+inline constexpr ctrl_t kEmpty = -128;
+inline constexpr ctrl_t kDeleted = -2;
+inline constexpr ctrl_t kSentinel = -1;
+
+inline bool IsFull(ctrl_t ctrl) {
+  return ctrl >= 0;
+}
+
+// A set of positions in a group, iterated from lowest to highest. Positions
+// are encoded as bit `position << kShift`.
+template <typename Mask, int kShift>
+class BitMask {
+ public:
+  explicit BitMask(Mask mask) : mask_(mask) {}
+
+  explicit operator bool() const { return mask_ != 0; }
+
+  // The lowest position that is set, which is also the number of positions
+  // before it.
+  size_t LowestBitSet() const {
+    return static_cast<size_t>(std::countr_zero(mask_)) >> kShift;
+  }
+
+  // The number of positions after the highest one that is set, counting
+  // from the top of the group.
+  size_t LeadingZeros(size_t width) const {
+    constexpr int kTotalBits = sizeof(Mask) * 8;
+    int extra_bits = kTotalBits - static_cast<int>(width << kShift);
+    return static_cast<size_t>(std::countl_zero(mask_) - extra_bits) >>
+           kShift;
+  }
+
+  BitMask begin() const { return *this; }
+  BitMask end() const { return BitMask(0); }
+  size_t operator*() const { return LowestBitSet(); }
+  BitMask& operator++() {
+    mask_ &= mask_ - 1;
+    return *this;
+  }
+  friend bool operator==(const BitMask& lhs, const BitMask& rhs) {
+    return lhs.mask_ == rhs.mask_;
+  }
+
+ private:
+  Mask mask_;
+};
+
+#if defined(ARCH_CPU_X86_FAMILY) && defined(__SSE2__)
+
+// 16 control bytes, classified with SSE2 compares.
+class Group {
+ public:
+  static constexpr size_t kWidth = 16;
+
+  explicit Group(const ctrl_t* ctrl)
+      : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) {}
+
+  // The slots whose control byte is `h2`.
+  BitMask<uint32_t, 0> Match(uint8_t h2) const {
+    return BitMask<uint32_t, 0>(ToMask(
+        _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(h2)), ctrl_)));
+  }
+
+  BitMask<uint32_t, 0> MaskEmpty() const {
+    return BitMask<uint32_t, 0>(
+        ToMask(_mm_cmpeq_epi8(_mm_set1_epi8(kEmpty), ctrl_)));
+  }
+
+  BitMask<uint32_t, 0> MaskEmptyOrDeleted() const {
+    return BitMask<uint32_t, 0>(
+        ToMask(_mm_cmpgt_epi8(_mm_set1_epi8(kSentinel), ctrl_)));
+  }
+
+  // The number of empty or deleted slots at the start of the group.
+  size_t CountLeadingEmptyOrDeleted() const {
+    uint32_t mask = ToMask(_mm_cmpgt_epi8(_mm_set1_epi8(kSentinel), ctrl_));
+    return static_cast<size_t>(std::countr_zero(mask + 1));
+  }
+
+ private:
+  static uint32_t ToMask(__m128i bytes) {
+    return static_cast<uint32_t>(_mm_movemask_epi8(bytes));
+  }
+
+  __m128i ctrl_;
+};
+
+#else
+
+// 8 control bytes, classified with bit tricks on a word ("SIMD within a
+// register"). Each position's bit is the high bit of its byte.
+class Group {
+ public:
+  static constexpr size_t kWidth = 8;
+
+  explicit Group(const ctrl_t* ctrl) {
+    // Little endian, as Chromium only builds for little-endian machines.
+    memcpy(&ctrl_, ctrl, sizeof(ctrl_));
+  }
+
+  // The slots whose control byte is `h2`. This may include false positives
+  // just above a true match, which only cost a key comparison.
+  BitMask<uint64_t, 3> Match(uint8_t h2) const {
+    uint64_t x = ctrl_ ^ (kLsbs * h2);
+    return BitMask<uint64_t, 3>((x - kLsbs) & ~x & kMsbs);
+  }
+
+  // kEmpty is the only value with the high bit set and bit 1 clear.
+  BitMask<uint64_t, 3> MaskEmpty() const {
+    return BitMask<uint64_t, 3>(ctrl_ & ~(ctrl_ << 6) & kMsbs);
+  }
+
+  // kEmpty and kDeleted are the only values with the high bit set and bit 0
+  // clear.
+  BitMask<uint64_t, 3> MaskEmptyOrDeleted() const {
+    return BitMask<uint64_t, 3>(ctrl_ & ~(ctrl_ << 7) & kMsbs);
+  }
+
+  // The number of empty or deleted slots at the start of the group. Bit 0 of
+  // each byte of the mask is set for full and sentinel bytes.
+  size_t CountLeadingEmptyOrDeleted() const {
+    return static_cast<size_t>(
+               std::countr_zero((ctrl_ | ~(ctrl_ >> 7)) & kLsbs)) >>
+           3;
+  }
+
+ private:
+  static constexpr uint64_t kLsbs = 0x0101010101010101u;
+  static constexpr uint64_t kMsbs = 0x8080808080808080u;
+
+  uint64_t ctrl_;
+};
+
+#endif
+
+// The control bytes of a table with no capacity, which every lookup treats
+// as a group with one empty slot.
+alignas(16) inline constexpr ctrl_t kEmptyGroup[16] = {
+    kSentinel, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty,
+    kEmpty,    kEmpty, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty};
+
+// Spreads the entropy of a hash across all of its bits. std::hash is the
+// identity for integers in common standard libraries, which would leave H2,
+// the low bits, the same for every small key.
+inline size_t MixHash(size_t hash) {
+  uint64_t x = hash;
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdu;
+  x ^= x >> 33;
+  return static_cast<size_t>(x);
+}
+
+// The table's slot type and how to get a slot's key, for sets.
+template <typename Key>
+struct FlatHashSetPolicy {
+  using key_type = Key;
+  using slot_type = Key;
+  using value_type = const Key;
+
+  static const Key& GetKey(const slot_type& slot) { return slot; }
+
+  // Moves the element in `from` to the uninitialized `to`, and destroys the
+  // original.
+  static void Transfer(slot_type* to, slot_type* from) {
+    std::construct_at(to, std::move(*from));
+    std::destroy_at(from);
+  }
+};
+
+// The table's slot type and how to get a slot's key, for maps.
+template <typename Key, typename Value>
+struct FlatHashMapPolicy {
+  using key_type = Key;
+  using slot_type = std::pair<const Key, Value>;
+  using value_type = slot_type;
+
+  static const Key& GetKey(const slot_type& slot) { return slot.first; }
+
+  // Moves the element in `from` to the uninitialized `to`, and destroys the
+  // original. The key is const only to protect it from users of the table;
+  // moving it is safe because the original is destroyed right after.
+  static void Transfer(slot_type* to, slot_type* from) {
+    std::construct_at(to, std::move(const_cast<Key&>(from->first)),
+                      std::move(from->second));
+    std::destroy_at(from);
+  }
+};
+
+// Selects the argument type of lookups. These are member alias templates,
+// rather than std::conditional_t, so that K can be deduced through them.
+template <bool kIsTransparent>
+struct KeyArgSelector {
+  template <typename K, typename KeyType>
+  using type = KeyType;
+};
+template <>
+struct KeyArgSelector<true> {
+  template <typename K, typename KeyType>
+  using type = K;
+};
+
+template <typename Policy, typename Hash, typename Eq>
+class RawHashTable {
+ public:
+  using key_type = typename Policy::key_type;
+  using value_type = std::remove_const_t<typename Policy::value_type>;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using hasher = Hash;
+  using key_equal = Eq;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+
+ protected:
+  using slot_type = typename Policy::slot_type;
+
+  static constexpr bool kIsTransparent =
+      requires { typename Hash::is_transparent; } &&
+      requires { typename Eq::is_transparent; };
+
+  // The type lookups take: any K with transparent functors, so that K is
+  // deduced, and otherwise key_type.
+  template <typename K>
+  using KeyArg =
+      typename KeyArgSelector<kIsTransparent>::template type<K, key_type>;
+
+ public:
+  template <bool kConst>
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = RawHashTable::value_type;
+    using difference_type = ptrdiff_t;
+    using reference = std::conditional_t<kConst,
+                                         const typename Policy::value_type&,
+                                         typename Policy::value_type&>;
+    using pointer = std::remove_reference_t<reference>*;
+
+    Iterator() = default;
+
+    // Allows converting an iterator to a const_iterator.
+    template <bool kOtherConst>
+      requires(kConst && !kOtherConst)
+    Iterator(const Iterator<kOtherConst>& other)  // NOLINT
+        : ctrl_(other.ctrl_), slot_(other.slot_) {}
+
+    reference operator*() const {
+      DCHECK(ctrl_ && IsFull(*ctrl_));
+      return *slot_;
+    }
+    pointer operator->() const { return &**this; }
+
+    Iterator& operator++() {
+      DCHECK(ctrl_ && IsFull(*ctrl_));
+      // SAFETY: The control bytes end with a sentinel, which stops
+      // SkipEmptyOrDeleted(), and there is a slot for each control byte
+      // before it.
+      UNSAFE_BUFFERS(++ctrl_, ++slot_);
+      SkipEmptyOrDeleted();
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator result = *this;
+      ++*this;
+      return result;
+    }
+
+    friend bool operator==(const Iterator& lhs, const Iterator& rhs) {
+      return lhs.ctrl_ == rhs.ctrl_;
+    }
+
+   private:
+    friend class RawHashTable;
+    template <bool>
+    friend class Iterator;
+
+    Iterator(const ctrl_t* ctrl, slot_type* slot) : ctrl_(ctrl), slot_(slot) {}
+
+    void SkipEmptyOrDeleted() {
+      while (*ctrl_ < kSentinel) {
+        size_t skip = Group(ctrl_).CountLeadingEmptyOrDeleted();
+        // SAFETY: As in operator++().
+        UNSAFE_BUFFERS(ctrl_ += skip, slot_ += skip);
+      }
+    }
+
+    const ctrl_t* ctrl_ = nullptr;
+    slot_type* slot_ = nullptr;
+  };
+
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  RawHashTable() = default;
+
+  explicit RawHashTable(size_t bucket_count) {
+    if (bucket_count) {
+      Resize(NormalizeCapacity(bucket_count));
+    }
+  }
+
+  RawHashTable(const RawHashTable& other) : hash_(other.hash_), eq_(other.eq_) {
+    reserve(other.size());
+    for (const auto& value : other) {
+      size_t hash = HashOf(Policy::GetKey(value));
+      size_t index = FindFirstNonFull(hash);
+      SetCtrl(index, H2(hash));
+      std::construct_at(SlotAt(index), value);
+    }
+    size_ = other.size_;
+    growth_left_ -= other.size_;
+  }
+
+  RawHashTable(RawHashTable&& other) noexcept
+      : ctrl_(std::exchange(other.ctrl_, EmptyGroup())),
+        slots_(std::exchange(other.slots_, nullptr)),
+        size_(std::exchange(other.size_, 0u)),
+        capacity_(std::exchange(other.capacity_, 0u)),
+        growth_left_(std::exchange(other.growth_left_, 0u)),
+        hash_(other.hash_),
+        eq_(other.eq_) {}
+
+  RawHashTable& operator=(const RawHashTable& other) {
+    if (this != &other) {
+      RawHashTable copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+
+  RawHashTable& operator=(RawHashTable&& other) noexcept {
+    if (this != &other) {
+      RawHashTable moved(std::move(other));
+      swap(moved);
+    }
+    return *this;
+  }
+
+  ~RawHashTable() { DestroySlotsAndDeallocate(); }
+
+  iterator begin() {
+    iterator it(ctrl_, slots_);
+    it.SkipEmptyOrDeleted();
+    return it;
+  }
+  iterator end() {
+    // SAFETY: `ctrl_` has `capacity_` bytes before the sentinel.
+    return iterator(UNSAFE_BUFFERS(ctrl_ + capacity_), nullptr);
+  }
+  const_iterator begin() const {
+    return const_cast<RawHashTable*>(this)->begin();
+  }
+  const_iterator end() const { return const_cast<RawHashTable*>(this)->end(); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+  size_t capacity() const { return capacity_; }
+
+  float load_factor() const {
+    return capacity_ ? static_cast<float>(size_) / capacity_ : 0.0f;
+  }
+
+  // Destroys all elements. Keeps the storage.
+  void clear() {
+    if (!capacity_) {
+      return;
+    }
+    DestroySlots();
+    ResetCtrl();
+    size_ = 0;
+    growth_left_ = CapacityToGrowth(capacity_);
+  }
+
+  // Ensures that `count` elements fit without rehashing.
+  void reserve(size_t count) {
+    if (count > size_ + growth_left_) {
+      Resize(NormalizeCapacity(GrowthToLowerboundCapacity(count)));
+    }
+  }
+
+  // Rehashes to a capacity of at least `count` slots, and at least enough
+  // for the current elements. rehash(0) shrinks the table to fit, and drops
+  // any deleted slots.
+  void rehash(size_t count) {
+    if (count == 0 && size_ == 0) {
+      DestroySlotsAndDeallocate();
+      ctrl_ = EmptyGroup();
+      slots_ = nullptr;
+      capacity_ = 0;
+      growth_left_ = 0;
+      return;
+    }
+    size_t new_capacity = NormalizeCapacity(
+        std::max(count, GrowthToLowerboundCapacity(size_)));
+    if (count == 0 || new_capacity > capacity_) {
+      Resize(new_capacity);
+    }
+  }
+
+  template <typename K = key_type>
+  iterator find(const KeyArg<K>& key) {
+    size_t index;
+    if (!FindIndex(key, index)) {
+      return end();
+    }
+    return IteratorAt(index);
+  }
+  template <typename K = key_type>
+  const_iterator find(const KeyArg<K>& key) const {
+    return const_cast<RawHashTable*>(this)->template find<K>(key);
+  }
+
+  template <typename K = key_type>
+  bool contains(const KeyArg<K>& key) const {
+    size_t index;
+    return FindIndex(key, index);
+  }
+
+  template <typename K = key_type>
+  size_t count(const KeyArg<K>& key) const {
+    return contains<K>(key) ? 1u : 0u;
+  }
+
+  // Erases the element at `position`. Unlike std::unordered_map, returns
+  // nothing, since finding the next element costs a scan; use
+  // `table.erase(it++)` to erase while iterating.
+  void erase(const_iterator position) {
+    DCHECK(position != end());
+    size_t index = static_cast<size_t>(position.ctrl_ - ctrl_);
+    std::destroy_at(SlotAt(index));
+    EraseMetaOnly(index);
+  }
+
+  // Erases the element with `key`, and returns the number erased (0 or 1).
+  template <typename K = key_type>
+    requires(!std::is_convertible_v<const K&, const_iterator>)
+  size_t erase(const KeyArg<K>& key) {
+    size_t index;
+    if (!FindIndex(key, index)) {
+      return 0;
+    }
+    std::destroy_at(SlotAt(index));
+    EraseMetaOnly(index);
+    return 1;
+  }
+
+  void swap(RawHashTable& other) noexcept {
+    std::swap(ctrl_, other.ctrl_);
+    std::swap(slots_, other.slots_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(growth_left_, other.growth_left_);
+    std::swap(hash_, other.hash_);
+    std::swap(eq_, other.eq_);
+  }
+
+  hasher hash_function() const { return hash_; }
+  key_equal key_eq() const { return eq_; }
+
+ protected:
+  // Returns the slot for `key`, and true if no element had that key and
+  // `construct(slot)` was called to construct one there. `construct` may
+  // read elements of the table: if the table grows, it runs before they move.
+  template <typename K, typename Construct>
+  std::pair<slot_type*, bool> FindOrConstruct(const K& key,
+                                              Construct construct) {
+    size_t hash = HashOf(key);
+    size_t index;
+    if (FindIndex(key, hash, index)) {
+      return {SlotAt(index), false};
+    }
+    index = FindFirstNonFull(hash);
+    if (growth_left_ == 0 && *CtrlAt(index) != kDeleted) [[unlikely]] {
+      RehashAndGrowIfNecessary([&] {
+        index = FindFirstNonFull(hash);
+        construct(SlotAt(index));
+        SetFull(index, hash);
+      });
+    } else {
+      construct(SlotAt(index));
+      SetFull(index, hash);
+    }
+    return {SlotAt(index), true};
+  }
+
+  iterator IteratorFor(slot_type* slot) {
+    return IteratorAt(static_cast<size_t>(slot - slots_));
+  }
+
+ private:
+  static ctrl_t* EmptyGroup() { return const_cast<ctrl_t*>(kEmptyGroup); }
+
+  // The capacity for `count` slots: the next power of two minus one.
+  static size_t NormalizeCapacity(size_t count) {
+    return count ? ~size_t{0} >> std::countl_zero(count) : 1;
+  }
+
+  // The number of elements a table of `capacity` slots can hold.
+  static size_t CapacityToGrowth(size_t capacity) {
+    // A group that is all full slots and the sentinel would never end a
+    // probe, so a table the size of a group keeps an empty slot.
+    if (Group::kWidth == 8 && capacity == 7) {
+      return 6;
+    }
+    return capacity - capacity / 8;
+  }
+
+  // The smallest capacity that can hold `growth` elements, not normalized.
+  static size_t GrowthToLowerboundCapacity(size_t growth) {
+    if (Group::kWidth == 8 && growth == 7) {
+      return 8;
+    }
+    return growth + (growth - 1) / 7;
+  }
+
+  static size_t NumClonedBytes() { return Group::kWidth - 1; }
+
+  template <typename K>
+  size_t HashOf(const K& key) const {
+    return MixHash(hash_(key));
+  }
+
+  // H1 also depends on the table's storage address, so iteration order
+  // differs between tables and does not follow insertion order.
+  size_t H1(size_t hash) const {
+    return (hash >> 7) ^ (reinterpret_cast<uintptr_t>(ctrl_) >> 12);
+  }
+  static uint8_t H2(size_t hash) { return hash & 0x7f; }
+
+  // The sequence of groups to examine for `hash`: offset, offset + 1 * kWidth,
+  // offset + 3 * kWidth, offset + 6 * kWidth, ... modulo the capacity.
+  class ProbeSeq {
+   public:
+    ProbeSeq(size_t hash, size_t mask) : mask_(mask), offset_(hash & mask) {}
+
+    size_t offset() const { return offset_; }
+    size_t offset(size_t i) const { return (offset_ + i) & mask_; }
+
+    void next() {
+      index_ += Group::kWidth;
+      offset_ = (offset_ + index_) & mask_;
+    }
+
+    // The number of slots examined before the current group.
+    size_t index() const { return index_; }
+
+   private:
+    size_t mask_;
+    size_t offset_;
+    size_t index_ = 0;
+  };
+
+  ctrl_t* CtrlAt(size_t index) const {
+    // SAFETY: Callers pass positions within the control bytes.
+    return UNSAFE_BUFFERS(ctrl_ + index);
+  }
+  slot_type* SlotAt(size_t index) const {
+    // SAFETY: Callers pass positions below `capacity_`.
+    return UNSAFE_BUFFERS(slots_ + index);
+  }
+  iterator IteratorAt(size_t index) {
+    return iterator(CtrlAt(index), SlotAt(index));
+  }
+
+  template <typename K>
+  bool FindIndex(const K& key, size_t& index) const {
+    return FindIndex(key, HashOf(key), index);
+  }
+
+  template <typename K>
+  bool FindIndex(const K& key, size_t hash, size_t& index) const {
+    ProbeSeq seq(H1(hash), capacity_);
+    while (true) {
+      Group group(CtrlAt(seq.offset()));
+      for (size_t i : group.Match(H2(hash))) {
+        size_t candidate = seq.offset(i);
+        if (eq_(Policy::GetKey(*SlotAt(candidate)), key)) [[likely]] {
+          index = candidate;
+          return true;
+        }
+      }
+      if (group.MaskEmpty()) [[likely]] {
+        return false;
+      }
+      seq.next();
+      DCHECK_LE(seq.index(), capacity_) << "Full table";
+    }
+  }
+
+  // Returns the first empty or deleted slot in `hash`'s probe sequence.
+  size_t FindFirstNonFull(size_t hash) const {
+    ProbeSeq seq(H1(hash), capacity_);
+    while (true) {
+      auto mask = Group(CtrlAt(seq.offset())).MaskEmptyOrDeleted();
+      if (mask) {
+        return seq.offset(mask.LowestBitSet());
+      }
+      seq.next();
+      DCHECK_LE(seq.index(), capacity_) << "Full table";
+    }
+  }
+
+  // Marks slot `index`, which was empty or deleted, as holding a new element
+  // with `hash`.
+  void SetFull(size_t index, size_t hash) {
+    ++size_;
+    growth_left_ -= *CtrlAt(index) == kEmpty ? 1 : 0;
+    SetCtrl(index, H2(hash));
+  }
+
+  // Makes room for at least one more element, calling `before_transfer()` as
+  // in Resize().
+  template <typename BeforeTransfer>
+  NOINLINE void RehashAndGrowIfNecessary(BeforeTransfer before_transfer) {
+    if (capacity_ == 0) {
+      Resize(1, before_transfer);
+    } else if (size_ <= CapacityToGrowth(capacity_) / 2) {
+      // At least half of the growth was used up by deleted slots, so
+      // dropping them makes enough room.
+      Resize(capacity_, before_transfer);
+    } else {
+      Resize(capacity_ * 2 + 1, before_transfer);
+    }
+  }
+
+  // Sets the control byte of slot `index`, and of its clone if it has one.
+  void SetCtrl(size_t index, ctrl_t value) {
+    *CtrlAt(index) = value;
+    *CtrlAt(((index - NumClonedBytes()) & capacity_) +
+            (NumClonedBytes() & capacity_)) = value;
+  }
+
+  void ResetCtrl() {
+    memset(ctrl_, kEmpty, capacity_ + 1 + NumClonedBytes());
+    *CtrlAt(capacity_) = kSentinel;
+  }
+
+  // Marks slot `index`, whose element has been destroyed, as free.
+  void EraseMetaOnly(size_t index) {
+    --size_;
+    // If the slot has an empty slot within a group's width on both sides, no
+    // probe sequence can have passed over it, so it can become empty again.
+    size_t index_before = (index - Group::kWidth) & capacity_;
+    auto empty_after = Group(CtrlAt(index)).MaskEmpty();
+    auto empty_before = Group(CtrlAt(index_before)).MaskEmpty();
+    bool was_never_full =
+        empty_before && empty_after &&
+        empty_after.LowestBitSet() +
+                empty_before.LeadingZeros(Group::kWidth) <
+            Group::kWidth;
+    SetCtrl(index, was_never_full ? kEmpty : kDeleted);
+    growth_left_ += was_never_full ? 1 : 0;
+  }
+
+  // The storage is the control bytes followed by the slots.
+  static size_t SlotOffset(size_t capacity) {
+    return (capacity + 1 + NumClonedBytes() + alignof(slot_type) - 1) &
+           ~(alignof(slot_type) - 1);
+  }
+  static size_t AllocSize(size_t capacity) {
+    CHECK_LE(capacity, (SIZE_MAX - SlotOffset(capacity)) / sizeof(slot_type));
+    return SlotOffset(capacity) + capacity * sizeof(slot_type);
+  }
+
+  // Moves the elements to new storage with `new_capacity` slots.
+  void Resize(size_t new_capacity) {
+    Resize(new_capacity, [] {});
+  }
+
+  // As above, but calls `before_transfer()` once the new storage is ready and
+  // before any element moves to it, so that it can insert an element built
+  // from ones that are still in the old storage.
+  template <typename BeforeTransfer>
+  void Resize(size_t new_capacity, BeforeTransfer before_transfer) {
+    ctrl_t* old_ctrl = ctrl_;
+    slot_type* old_slots = slots_;
+    size_t old_capacity = capacity_;
+
+    auto* storage = static_cast<uint8_t*>(::operator new(
+        AllocSize(new_capacity), std::align_val_t{alignof(slot_type)}));
+    ctrl_ = reinterpret_cast<ctrl_t*>(storage);
+    // SAFETY: The storage holds the control bytes and then the slots.
+    slots_ = reinterpret_cast<slot_type*>(
+        UNSAFE_BUFFERS(storage + SlotOffset(new_capacity)));
+    capacity_ = new_capacity;
+    ResetCtrl();
+    growth_left_ = CapacityToGrowth(capacity_) - size_;
+    before_transfer();
+
+    for (size_t i = 0; i < old_capacity; ++i) {
+      // SAFETY: `i` is below the old capacity.
+      if (IsFull(UNSAFE_BUFFERS(old_ctrl[i]))) {
+        slot_type* old_slot = UNSAFE_BUFFERS(old_slots + i);
+        size_t hash = HashOf(Policy::GetKey(*old_slot));
+        size_t index = FindFirstNonFull(hash);
+        SetCtrl(index, H2(hash));
+        Policy::Transfer(SlotAt(index), old_slot);
+      }
+    }
+    if (old_capacity) {
+      ::operator delete(old_ctrl, std::align_val_t{alignof(slot_type)});
+    }
+  }
+
+  void DestroySlots() {
+    if constexpr (!std::is_trivially_destructible_v<slot_type>) {
+      for (size_t i = 0; i < capacity_; ++i) {
+        if (IsFull(*CtrlAt(i))) {
+          std::destroy_at(SlotAt(i));
+        }
+      }
+    }
+  }
+
+  void DestroySlotsAndDeallocate() {
+    if (capacity_) {
+      DestroySlots();
+      ::operator delete(ctrl_, std::align_val_t{alignof(slot_type)});
+    }
+  }
+
+  ctrl_t* ctrl_ = EmptyGroup();
+  slot_type* slots_ = nullptr;
+  size_t size_ = 0;
+  size_t capacity_ = 0;
+  size_t growth_left_ = 0;
+  NO_UNIQUE_ADDRESS Hash hash_;
+  NO_UNIQUE_ADDRESS Eq eq_;
+};
+
+}  // namespace internal
+
+}  // namespace base
+
+#endif  // MINI_CHROMIUM_BASE_CONTAINERS_RAW_HASH_TABLE_INTERNAL_H_
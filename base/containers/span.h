@@ -38,6 +38,9 @@ template <typename T,
           typename InternalPtrType = T*>
 class span;
 
+template <typename T, size_t ChunkSize>
+class ChunkedSpan;
+
 namespace internal {
 
 template <typename From, typename To>
@@ -226,6 +229,11 @@ constexpr bool span_cmp(span<T, N> l, span<U, M> r);
 // - as_byte_span() function.
 // - as_writable_byte_span() function.
 // - copy_from() method.
+// - copy_prefix_from() method.
+// - fill() method.
+// - chunked() method and ChunkedSpan.
+// - transform_into() function.
+// - for_each_chunk() function.
 // - span_from_ref() function.
 // - byte_span_from_ref() function.
 // - span_from_cstring() function.
@@ -583,6 +591,46 @@ class GSL_POINTER span {
         std::copy(other.data(), other.data() + other.size(), data()));
   }
 
+  // Bounds-checked copy from a non-overlapping span into the front of this
+  // span, leaving any elements beyond `other.size()` unchanged. If the two
+  // spans overlap, Undefined Behaviour occurs.
+  //
+  // # Checks
+  // The function CHECKs that the `other` span is no larger than itself and
+  // will terminate otherwise.
+  constexpr void copy_prefix_from(span<const T> other)
+    requires(!std::is_const_v<T>)
+  {
+    CHECK_LE(other.size(), size());
+    // SAFETY: `other.size()` is at most `size()`, which was just checked, so
+    // the first `other.size()` elements of this span are in bounds.
+    UNSAFE_BUFFERS(span<T>(data(), other.size())).copy_from(other);
+  }
+
+  // Assigns `value` to every element. Unlike std::ranges::fill() on the
+  // span's checked iterators, this compiles to an unchecked loop (or memset)
+  // that the compiler can vectorize.
+  constexpr void fill(const T& value)
+    requires(!std::is_const_v<T>)
+  {
+    // SAFETY: span provides that data() points to at least size() many
+    // elements.
+    UNSAFE_BUFFERS(std::fill(data(), data() + size(), value));
+  }
+
+  // Returns a view of the span as consecutive `span<T, ChunkSize>` pieces,
+  // with any trailing elements that do not fill a whole chunk available from
+  // the view's remainder(). Bounds are computed once, when the view is
+  // created, so iterating it performs no per-chunk checks and the fixed
+  // extent of each chunk lets the compiler unroll or vectorize the loop body.
+  //
+  // This is a non-std extension that is inspired by the Rust
+  // slice::chunks_exact() method.
+  template <size_t ChunkSize>
+  constexpr ChunkedSpan<T, ChunkSize> chunked() const noexcept {
+    return ChunkedSpan<T, ChunkSize>(*this);
+  }
+
   // Implicit conversion from std::span<T, N> to base::span<T, N>.
   //
   // We get other conversions for free from std::span's constructors, but it
@@ -995,6 +1043,46 @@ class GSL_POINTER span<T, dynamic_extent, InternalPtrType> {
         std::copy(other.data(), other.data() + other.size(), data()));
   }
 
+  // Bounds-checked copy from a non-overlapping span into the front of this
+  // span, leaving any elements beyond `other.size()` unchanged. If the two
+  // spans overlap, Undefined Behaviour occurs.
+  //
+  // # Checks
+  // The function CHECKs that the `other` span is no larger than itself and
+  // will terminate otherwise.
+  constexpr void copy_prefix_from(span<const T> other)
+    requires(!std::is_const_v<T>)
+  {
+    CHECK_LE(other.size(), size());
+    // SAFETY: `other.size()` is at most `size()`, which was just checked, so
+    // the first `other.size()` elements of this span are in bounds.
+    UNSAFE_BUFFERS(span<T>(data(), other.size())).copy_from(other);
+  }
+
+  // Assigns `value` to every element. Unlike std::ranges::fill() on the
+  // span's checked iterators, this compiles to an unchecked loop (or memset)
+  // that the compiler can vectorize.
+  constexpr void fill(const T& value)
+    requires(!std::is_const_v<T>)
+  {
+    // SAFETY: span provides that data() points to at least size() many
+    // elements.
+    UNSAFE_BUFFERS(std::fill(data(), data() + size(), value));
+  }
+
+  // Returns a view of the span as consecutive `span<T, ChunkSize>` pieces,
+  // with any trailing elements that do not fill a whole chunk available from
+  // the view's remainder(). Bounds are computed once, when the view is
+  // created, so iterating it performs no per-chunk checks and the fixed
+  // extent of each chunk lets the compiler unroll or vectorize the loop body.
+  //
+  // This is a non-std extension that is inspired by the Rust
+  // slice::chunks_exact() method.
+  template <size_t ChunkSize>
+  constexpr ChunkedSpan<T, ChunkSize> chunked() const noexcept {
+    return ChunkedSpan<T, ChunkSize>(*this);
+  }
+
   // Compares two spans for equality by comparing the objects pointed to by the
   // spans. The operation is defined for spans of different types as long as the
   // types are themselves comparable.
@@ -1035,6 +1123,144 @@ class GSL_POINTER span<T, dynamic_extent, InternalPtrType> {
   size_t size_ = 0;
 };
 
+// A view of a span as consecutive fixed-size chunks, returned by
+// span::chunked<ChunkSize>(). Iterating it yields `span<T, ChunkSize>` values
+// covering the first `size() * ChunkSize` elements; the elements left over are
+// available from remainder().
+//
+// The number of whole chunks is computed once at construction, after which
+// the iterators are plain pointers, so a loop over the chunks has no bounds
+// checks in it.
+template <typename T, size_t ChunkSize>
+class ChunkedSpan {
+ public:
+  static_assert(ChunkSize > 0 && ChunkSize != dynamic_extent,
+                "ChunkSize must be a positive constant.");
+
+  class iterator {
+   public:
+    using iterator_concept = std::forward_iterator_tag;
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = span<T, ChunkSize>;
+    using difference_type = ptrdiff_t;
+    using pointer = void;
+    using reference = span<T, ChunkSize>;
+
+    constexpr iterator() = default;
+
+    constexpr span<T, ChunkSize> operator*() const {
+      // SAFETY: `current_` is before the end of the whole chunks, so at least
+      // ChunkSize elements follow it.
+      return UNSAFE_BUFFERS(span<T, ChunkSize>(current_, ChunkSize));
+    }
+
+    constexpr iterator& operator++() {
+      // SAFETY: ChunkedSpan only creates iterators at chunk boundaries, and
+      // callers may not increment past end().
+      current_ = UNSAFE_BUFFERS(current_ + ChunkSize);
+      return *this;
+    }
+
+    constexpr iterator operator++(int) {
+      iterator result = *this;
+      ++*this;
+      return result;
+    }
+
+    friend constexpr bool operator==(iterator, iterator) = default;
+
+   private:
+    friend class ChunkedSpan;
+
+    constexpr explicit iterator(T* current) : current_(current) {}
+
+    T* current_ = nullptr;
+  };
+
+  constexpr explicit ChunkedSpan(span<T> whole)
+      : data_(whole.data()),
+        size_(whole.size() / ChunkSize),
+        remainder_(whole.last(whole.size() % ChunkSize)) {}
+
+  // The number of whole chunks.
+  constexpr size_t size() const noexcept { return size_; }
+  constexpr bool empty() const noexcept { return size_ == 0; }
+
+  constexpr iterator begin() const noexcept { return iterator(data_); }
+  constexpr iterator end() const noexcept {
+    // SAFETY: The chunks cover the first `size_ * ChunkSize` elements of the
+    // span this view was created from.
+    return iterator(UNSAFE_BUFFERS(data_ + size_ * ChunkSize));
+  }
+
+  // Returns the chunk at `index`.
+  //
+  // # Checks
+  // The function CHECKs that `index` is less than size() and will terminate
+  // otherwise.
+  constexpr span<T, ChunkSize> operator[](size_t index) const {
+    CHECK_LT(index, size_);
+    // SAFETY: `index` is less than the number of whole chunks, checked above.
+    return UNSAFE_BUFFERS(
+        span<T, ChunkSize>(data_ + index * ChunkSize, ChunkSize));
+  }
+
+  // The trailing elements that do not make up a whole chunk; fewer than
+  // ChunkSize of them.
+  constexpr span<T> remainder() const noexcept { return remainder_; }
+
+ private:
+  T* data_;
+  size_t size_;
+  span<T> remainder_;
+};
+
+// Writes `op(input[i])` to `output[i]` for every element of `input`. The sizes
+// are checked once, up front, so the loop itself runs over raw pointers and
+// can be vectorized when `op` allows it.
+//
+// # Checks
+// The function CHECKs that `input` and `output` are the same size and will
+// terminate otherwise.
+template <typename In,
+          size_t InExtent,
+          typename Out,
+          size_t OutExtent,
+          typename Op>
+  requires(!std::is_const_v<Out> &&
+           std::is_assignable_v<Out&, std::invoke_result_t<Op&, In&>>)
+constexpr void transform_into(span<In, InExtent> input,
+                              span<Out, OutExtent> output,
+                              Op op) {
+  static_assert(InExtent == dynamic_extent || OutExtent == dynamic_extent ||
+                    InExtent == OutExtent,
+                "Spans must be the same size.");
+  CHECK_EQ(input.size(), output.size());
+  In* in = input.data();
+  Out* out = output.data();
+  for (size_t i = 0; i < input.size(); ++i) {
+    // SAFETY: `i` is less than the size of both spans, checked above.
+    UNSAFE_BUFFERS(out[i] = op(in[i]));
+  }
+}
+
+// Calls `function` with each consecutive `span<T, ChunkSize>` of `s`, then
+// returns the trailing elements that do not make up a whole chunk, so that
+// callers can process them separately:
+//
+//   span<const uint8_t> tail = for_each_chunk<16>(
+//       bytes, [&](span<const uint8_t, 16> block) { ProcessBlock(block); });
+//   ProcessPartialBlock(tail);
+template <size_t ChunkSize, typename T, size_t Extent, typename Function>
+  requires(std::invocable<Function&, span<T, ChunkSize>>)
+constexpr span<T> for_each_chunk(span<T, Extent> s, Function function) {
+  ChunkedSpan<T, ChunkSize> chunks(s);
+  for (span<T, ChunkSize> chunk : chunks) {
+    function(chunk);
+  }
+  return chunks.remainder();
+}
+
 // [span.deduct], deduction guides.
 template <typename It, typename EndOrSize>
   requires(std::contiguous_iterator<It>)
@@ -0,0 +1,63 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MINI_CHROMIUM_BASE_CONTAINERS_SPAN_FIELD_INTERNAL_H_
+#define MINI_CHROMIUM_BASE_CONTAINERS_SPAN_FIELD_INTERNAL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <bit>
+#include <concepts>
+#include <type_traits>
+
+#include "base/containers/span.h"
+#include "base/numerics/basic_ops_impl.h"
+
+namespace base::internal {
+
+// A value that SpanReader and SpanWriter can decode from or encode to a fixed
+// number of bytes in a given byte order: any integer other than bool, float
+// and double.
+template <typename V>
+concept SpanField = std::is_arithmetic_v<V> && !std::same_as<V, bool> &&
+                    (sizeof(V) == 1u || sizeof(V) == 2u || sizeof(V) == 4u ||
+                     sizeof(V) == 8u);
+
+// The unsigned integer with the same size as the SpanField `V`.
+template <typename V>
+using SpanFieldBits = std::conditional_t<
+    sizeof(V) == 1u,
+    uint8_t,
+    std::conditional_t<
+        sizeof(V) == 2u,
+        uint16_t,
+        std::conditional_t<sizeof(V) == 4u, uint32_t, uint64_t>>>;
+
+template <SpanField V>
+constexpr V DecodeSpanField(span<const uint8_t, sizeof(V)> bytes,
+                            bool big_endian) {
+  using Bits = SpanFieldBits<V>;
+  Bits bits = numerics::internal::FromLittleEndian<Bits>(bytes);
+  if (big_endian) {
+    bits = numerics::internal::SwapBytes(bits);
+  }
+  return std::bit_cast<V>(bits);
+}
+
+template <SpanField V>
+constexpr void EncodeSpanField(V value,
+                               bool big_endian,
+                               span<uint8_t, sizeof(V)> bytes) {
+  using Bits = SpanFieldBits<V>;
+  Bits bits = std::bit_cast<Bits>(value);
+  if (big_endian) {
+    bits = numerics::internal::SwapBytes(bits);
+  }
+  bytes.copy_from(numerics::internal::ToLittleEndian(bits));
+}
+
+}  // namespace base::internal
+
+#endif  // MINI_CHROMIUM_BASE_CONTAINERS_SPAN_FIELD_INTERNAL_H_
@@ -0,0 +1,324 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MINI_CHROMIUM_BASE_CONTAINERS_SPAN_READER_H_
+#define MINI_CHROMIUM_BASE_CONTAINERS_SPAN_READER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <concepts>
+#include <optional>
+#include <type_traits>
+
+#include "base/compiler_specific.h"
+#include "base/containers/span.h"
+#include "base/containers/span_field_internal.h"
+#include "base/numerics/safe_conversions.h"
+#include "base/numerics/varint.h"
+
+namespace base {
+
+// A Reader to consume elements from the front of a span dynamically.
+//
+// SpanReader is used to split off prefix spans from a larger span, reporting
+// errors if there's not enough room left (instead of crashing, as would happen
+// with span directly). The spans it returns alias the buffer being read, so
+// nothing is copied unless ReadCopy() is used.
+//
+// When T is a byte type, SpanReader also decodes integers and floating point
+// values in a given byte order, unsigned LEB128 varints, and length-prefixed
+// sub-spans. A failed read leaves the reader where it was.
+//
+// A fixed-layout header can be decoded with a single bounds check by reading
+// all of its fields at once:
+//
+//   auto reader = SpanReader(bytes);
+//   uint32_t magic;
+//   uint16_t version;
+//   uint16_t flags;
+//   uint64_t length;
+//   if (!reader.ReadBigEndian(magic, version, flags, length)) {
+//     return false;
+//   }
+//   std::optional<span<const uint8_t>> payload = reader.Read(length);
+template <class T>
+class SpanReader {
+  static_assert(!std::is_reference_v<T>,
+                "SpanReader can not read references");
+
+ public:
+  // Construct SpanReader from a span.
+  constexpr explicit SpanReader(span<T> buf)
+      : buf_(buf), original_size_(buf_.size()) {}
+
+  // Returns a span over the next `n` objects, if there are enough objects left.
+  // Otherwise, it returns nullopt and does nothing.
+  constexpr std::optional<span<T>> Read(StrictNumeric<size_t> n) {
+    if (n > remaining()) {
+      return std::nullopt;
+    }
+    auto [lhs, rhs] = buf_.split_at(n);
+    buf_ = rhs;
+    return lhs;
+  }
+
+  // Returns a fixed-size span over the next `N` objects, if there are enough
+  // objects left. Otherwise, it returns nullopt and does nothing.
+  template <size_t N>
+  constexpr std::optional<span<T, N>> Read() {
+    if (N > remaining()) {
+      return std::nullopt;
+    }
+    auto [lhs, rhs] = buf_.template split_at<N>();
+    buf_ = rhs;
+    return lhs;
+  }
+
+  // Returns true and writes a span over the next `n` objects into `out`, if
+  // there are enough objects left. Otherwise, it returns false and does
+  // nothing.
+  constexpr bool ReadInto(StrictNumeric<size_t> n, span<T>& out) {
+    if (n > remaining()) {
+      return false;
+    }
+    auto [lhs, rhs] = buf_.split_at(n);
+    out = lhs;
+    buf_ = rhs;
+    return true;
+  }
+
+  // Returns true and copies objects into `out`, if there are enough objects
+  // left to fill `out`. Otherwise, it returns false and does nothing.
+  constexpr bool ReadCopy(span<std::remove_const_t<T>> out) {
+    if (out.size() > remaining()) {
+      return false;
+    }
+    auto [lhs, rhs] = buf_.split_at(out.size());
+    out.copy_from(lhs);
+    buf_ = rhs;
+    return true;
+  }
+
+  // Skips over the next `n` objects and returns a span over them, if there are
+  // enough objects left. Otherwise, it returns nullopt and does nothing.
+  constexpr std::optional<span<T>> Skip(StrictNumeric<size_t> n) {
+    return Read(n);
+  }
+
+  // Reads one or more values stored back to back in big-endian byte order,
+  // checking once that there is room for all of them. Returns false, without
+  // changing any of `fields`, if there are not enough bytes left.
+  template <internal::SpanField... Fields>
+    requires(sizeof...(Fields) > 0u &&
+             std::same_as<std::remove_const_t<T>, uint8_t>)
+  constexpr bool ReadBigEndian(Fields&... fields) {
+    return ReadFields(/*big_endian=*/true, fields...);
+  }
+
+  // Like ReadBigEndian(), for values stored in little-endian byte order.
+  template <internal::SpanField... Fields>
+    requires(sizeof...(Fields) > 0u &&
+             std::same_as<std::remove_const_t<T>, uint8_t>)
+  constexpr bool ReadLittleEndian(Fields&... fields) {
+    return ReadFields(/*big_endian=*/false, fields...);
+  }
+
+  // For a SpanReader over bytes, reads one unsigned integer of the named width
+  // and byte order and writes it into `value`. Returns false and does nothing
+  // if there are not enough bytes left. Native endian is little endian, as
+  // Chromium only builds for little-endian machines.
+  constexpr bool ReadU8BigEndian(uint8_t& value) {
+    return ReadBigEndian(value);
+  }
+  constexpr bool ReadU16BigEndian(uint16_t& value) {
+    return ReadBigEndian(value);
+  }
+  constexpr bool ReadU32BigEndian(uint32_t& value) {
+    return ReadBigEndian(value);
+  }
+  constexpr bool ReadU64BigEndian(uint64_t& value) {
+    return ReadBigEndian(value);
+  }
+  constexpr bool ReadU8LittleEndian(uint8_t& value) {
+    return ReadLittleEndian(value);
+  }
+  constexpr bool ReadU16LittleEndian(uint16_t& value) {
+    return ReadLittleEndian(value);
+  }
+  constexpr bool ReadU32LittleEndian(uint32_t& value) {
+    return ReadLittleEndian(value);
+  }
+  constexpr bool ReadU64LittleEndian(uint64_t& value) {
+    return ReadLittleEndian(value);
+  }
+  constexpr bool ReadU8NativeEndian(uint8_t& value) {
+    return ReadLittleEndian(value);
+  }
+  constexpr bool ReadU16NativeEndian(uint16_t& value) {
+    return ReadLittleEndian(value);
+  }
+  constexpr bool ReadU32NativeEndian(uint32_t& value) {
+    return ReadLittleEndian(value);
+  }
+  constexpr bool ReadU64NativeEndian(uint64_t& value) {
+    return ReadLittleEndian(value);
+  }
+
+  // For a SpanReader over bytes, reads one signed integer of the named width
+  // and byte order and writes it into `value`. Returns false and does nothing
+  // if there are not enough bytes left.
+  constexpr bool ReadI8BigEndian(int8_t& value) {
+    return ReadBigEndian(value);
+  }
+  constexpr bool ReadI16BigEndian(int16_t& value) {
+    return ReadBigEndian(value);
+  }
+  constexpr bool ReadI32BigEndian(int32_t& value) {
+    return ReadBigEndian(value);
+  }
+  constexpr bool ReadI64BigEndian(int64_t& value) {
+    return ReadBigEndian(value);
+  }
+  constexpr bool ReadI8LittleEndian(int8_t& value) {
+    return ReadLittleEndian(value);
+  }
+  constexpr bool ReadI16LittleEndian(int16_t& value) {
+    return ReadLittleEndian(value);
+  }
+  constexpr bool ReadI32LittleEndian(int32_t& value) {
+    return ReadLittleEndian(value);
+  }
+  constexpr bool ReadI64LittleEndian(int64_t& value) {
+    return ReadLittleEndian(value);
+  }
+  constexpr bool ReadI8NativeEndian(int8_t& value) {
+    return ReadLittleEndian(value);
+  }
+  constexpr bool ReadI16NativeEndian(int16_t& value) {
+    return ReadLittleEndian(value);
+  }
+  constexpr bool ReadI32NativeEndian(int32_t& value) {
+    return ReadLittleEndian(value);
+  }
+  constexpr bool ReadI64NativeEndian(int64_t& value) {
+    return ReadLittleEndian(value);
+  }
+
+  // For a SpanReader over bytes, reads an IEEE 754 value of the named width
+  // and byte order and writes it into `value`. Returns false and does nothing
+  // if there are not enough bytes left.
+  constexpr bool ReadFloatBigEndian(float& value) {
+    return ReadBigEndian(value);
+  }
+  constexpr bool ReadDoubleBigEndian(double& value) {
+    return ReadBigEndian(value);
+  }
+  constexpr bool ReadFloatLittleEndian(float& value) {
+    return ReadLittleEndian(value);
+  }
+  constexpr bool ReadDoubleLittleEndian(double& value) {
+    return ReadLittleEndian(value);
+  }
+
+  // For a SpanReader over bytes, reads an unsigned LEB128 varint and writes it
+  // into `value`. Returns false and does nothing if the varint is truncated,
+  // or if its value does not fit in `value`'s type.
+  template <typename U>
+    requires(std::unsigned_integral<U> && !std::same_as<U, bool> &&
+             sizeof(U) <= sizeof(uint64_t) &&
+             std::same_as<std::remove_const_t<T>, uint8_t>)
+  constexpr bool ReadVarint(U& value) {
+    size_t size;
+    if (!numerics::DecodeVarint(buf_, size).AssignIfValid(&value)) {
+      return false;
+    }
+    buf_ = buf_.subspan(size);
+    return true;
+  }
+
+  // For a SpanReader over bytes, reads a length of the named width and byte
+  // order, and then returns a span over that many following bytes. Returns
+  // nullopt and does nothing if either the length or the bytes it covers are
+  // missing.
+  constexpr std::optional<span<T>> ReadU8LengthPrefixed() {
+    return ReadLengthPrefixed<uint8_t>(/*big_endian=*/true);
+  }
+  constexpr std::optional<span<T>> ReadU16LengthPrefixedBigEndian() {
+    return ReadLengthPrefixed<uint16_t>(/*big_endian=*/true);
+  }
+  constexpr std::optional<span<T>> ReadU32LengthPrefixedBigEndian() {
+    return ReadLengthPrefixed<uint32_t>(/*big_endian=*/true);
+  }
+  constexpr std::optional<span<T>> ReadU16LengthPrefixedLittleEndian() {
+    return ReadLengthPrefixed<uint16_t>(/*big_endian=*/false);
+  }
+  constexpr std::optional<span<T>> ReadU32LengthPrefixedLittleEndian() {
+    return ReadLengthPrefixed<uint32_t>(/*big_endian=*/false);
+  }
+
+  // Like the above, where the length is an unsigned LEB128 varint.
+  constexpr std::optional<span<T>> ReadVarintLengthPrefixed() {
+    span<T> saved = buf_;
+    size_t length;
+    if (ReadVarint(length)) {
+      if (std::optional<span<T>> result = Read(length)) {
+        return result;
+      }
+    }
+    buf_ = saved;
+    return std::nullopt;
+  }
+
+  // Returns the number of objects remaining to be read from the original span.
+  constexpr size_t remaining() const { return buf_.size(); }
+  // Returns the objects that have not yet been read, as a span.
+  constexpr span<T> remaining_span() const { return buf_; }
+
+  // Returns the number of objects read (or skipped) in the original span.
+  constexpr size_t num_read() const { return original_size_ - buf_.size(); }
+
+ private:
+  template <internal::SpanField... Fields>
+  constexpr bool ReadFields(bool big_endian, Fields&... fields) {
+    constexpr size_t kSize = (sizeof(Fields) + ...);
+    std::optional<span<T, kSize>> bytes = Read<kSize>();
+    if (!bytes) {
+      return false;
+    }
+    const uint8_t* field = bytes->data();
+    // SAFETY: `bytes` holds kSize bytes, the sum of the sizes of the fields,
+    // so each field's bytes lie within it.
+    ((fields = internal::DecodeSpanField<Fields>(
+          UNSAFE_BUFFERS(
+              span<const uint8_t, sizeof(Fields)>(field, sizeof(Fields))),
+          big_endian),
+      field = UNSAFE_BUFFERS(field + sizeof(Fields))),
+     ...);
+    return true;
+  }
+
+  template <typename Length>
+  constexpr std::optional<span<T>> ReadLengthPrefixed(bool big_endian) {
+    span<T> saved = buf_;
+    Length length;
+    if (ReadFields(big_endian, length)) {
+      if (std::optional<span<T>> result = Read(length)) {
+        return result;
+      }
+    }
+    buf_ = saved;
+    return std::nullopt;
+  }
+
+  span<T> buf_;
+  size_t original_size_;
+};
+
+template <class T, size_t N>
+SpanReader(span<T, N>) -> SpanReader<T>;
+
+}  // namespace base
+
+#endif  // MINI_CHROMIUM_BASE_CONTAINERS_SPAN_READER_H_
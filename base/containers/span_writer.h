@@ -0,0 +1,302 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MINI_CHROMIUM_BASE_CONTAINERS_SPAN_WRITER_H_
+#define MINI_CHROMIUM_BASE_CONTAINERS_SPAN_WRITER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <concepts>
+#include <limits>
+#include <optional>
+#include <type_traits>
+
+#include "base/compiler_specific.h"
+#include "base/containers/span.h"
+#include "base/containers/span_field_internal.h"
+#include "base/numerics/safe_conversions.h"
+#include "base/numerics/varint.h"
+
+namespace base {
+
+// A Writer to write into and consume elements from the front of a span
+// dynamically.
+//
+// SpanWriter is used to split off prefix spans from a larger span, reporting
+// errors if there's not enough room left (instead of crashing, as would happen
+// with span directly). Skip() returns the skipped span, which aliases the
+// buffer and can be filled in later, e.g. with a length once it is known.
+//
+// When T is uint8_t, SpanWriter also encodes integers and floating point
+// values in a given byte order, unsigned LEB128 varints, and length-prefixed
+// sub-spans. A failed write leaves the writer, and the buffer, unchanged.
+//
+// A fixed-layout header can be encoded with a single bounds check by writing
+// all of its fields at once:
+//
+//   auto writer = SpanWriter(buffer);
+//   if (!writer.WriteBigEndian(kMagic, kVersion, flags, payload.size()) ||
+//       !writer.Write(payload)) {
+//     return false;
+//   }
+template <class T>
+class SpanWriter {
+  static_assert(!std::is_const_v<T>,
+                "SpanWriter needs mutable access to its buffer");
+
+ public:
+  // Construct SpanWriter that writes to `buf`.
+  constexpr explicit SpanWriter(span<T> buf)
+      : buf_(buf), original_size_(buf_.size()) {}
+
+  // Returns true and writes the span `data` into the front of the inner span,
+  // if there is enough space left. Otherwise, it returns false and does
+  // nothing.
+  constexpr bool Write(span<const T> data) {
+    if (data.size() > remaining()) {
+      return false;
+    }
+    auto [lhs, rhs] = buf_.split_at(data.size());
+    lhs.copy_from(data);
+    buf_ = rhs;
+    return true;
+  }
+
+  // Returns true and writes `value` into the front of the inner span, if there
+  // is enough space left. Otherwise, it returns false and does nothing.
+  constexpr bool Write(const T& value) { return Write(span_from_ref(value)); }
+
+  // Skips over the next `n` objects, and returns a span that points to the
+  // skipped objects, if there are enough objects left. Otherwise, it returns
+  // nullopt and does nothing.
+  constexpr std::optional<span<T>> Skip(StrictNumeric<size_t> n) {
+    if (n > remaining()) {
+      return std::nullopt;
+    }
+    auto [lhs, rhs] = buf_.split_at(n);
+    buf_ = rhs;
+    return lhs;
+  }
+
+  // Skips over the next `N` objects, and returns a fixed-size span that points
+  // to the skipped objects, if there are enough objects left. Otherwise, it
+  // returns nullopt and does nothing.
+  template <size_t N>
+  constexpr std::optional<span<T, N>> Skip() {
+    if (N > remaining()) {
+      return std::nullopt;
+    }
+    auto [lhs, rhs] = buf_.template split_at<N>();
+    buf_ = rhs;
+    return lhs;
+  }
+
+  // Writes one or more values back to back in big-endian byte order, checking
+  // once that there is room for all of them. Returns false and writes nothing
+  // if there is not enough space left.
+  template <internal::SpanField... Fields>
+    requires(sizeof...(Fields) > 0u && std::same_as<T, uint8_t>)
+  constexpr bool WriteBigEndian(Fields... fields) {
+    return WriteFields(/*big_endian=*/true, fields...);
+  }
+
+  // Like WriteBigEndian(), writing the values in little-endian byte order.
+  template <internal::SpanField... Fields>
+    requires(sizeof...(Fields) > 0u && std::same_as<T, uint8_t>)
+  constexpr bool WriteLittleEndian(Fields... fields) {
+    return WriteFields(/*big_endian=*/false, fields...);
+  }
+
+  // For a SpanWriter over bytes, writes one unsigned integer of the named
+  // width and byte order. Returns false and does nothing if there is not
+  // enough space left. Native endian is little endian, as Chromium only builds
+  // for little-endian machines.
+  constexpr bool WriteU8BigEndian(uint8_t value) {
+    return WriteBigEndian(value);
+  }
+  constexpr bool WriteU16BigEndian(uint16_t value) {
+    return WriteBigEndian(value);
+  }
+  constexpr bool WriteU32BigEndian(uint32_t value) {
+    return WriteBigEndian(value);
+  }
+  constexpr bool WriteU64BigEndian(uint64_t value) {
+    return WriteBigEndian(value);
+  }
+  constexpr bool WriteU8LittleEndian(uint8_t value) {
+    return WriteLittleEndian(value);
+  }
+  constexpr bool WriteU16LittleEndian(uint16_t value) {
+    return WriteLittleEndian(value);
+  }
+  constexpr bool WriteU32LittleEndian(uint32_t value) {
+    return WriteLittleEndian(value);
+  }
+  constexpr bool WriteU64LittleEndian(uint64_t value) {
+    return WriteLittleEndian(value);
+  }
+  constexpr bool WriteU8NativeEndian(uint8_t value) {
+    return WriteLittleEndian(value);
+  }
+  constexpr bool WriteU16NativeEndian(uint16_t value) {
+    return WriteLittleEndian(value);
+  }
+  constexpr bool WriteU32NativeEndian(uint32_t value) {
+    return WriteLittleEndian(value);
+  }
+  constexpr bool WriteU64NativeEndian(uint64_t value) {
+    return WriteLittleEndian(value);
+  }
+
+  // For a SpanWriter over bytes, writes one signed integer of the named width
+  // and byte order. Returns false and does nothing if there is not enough
+  // space left.
+  constexpr bool WriteI8BigEndian(int8_t value) {
+    return WriteBigEndian(value);
+  }
+  constexpr bool WriteI16BigEndian(int16_t value) {
+    return WriteBigEndian(value);
+  }
+  constexpr bool WriteI32BigEndian(int32_t value) {
+    return WriteBigEndian(value);
+  }
+  constexpr bool WriteI64BigEndian(int64_t value) {
+    return WriteBigEndian(value);
+  }
+  constexpr bool WriteI8LittleEndian(int8_t value) {
+    return WriteLittleEndian(value);
+  }
+  constexpr bool WriteI16LittleEndian(int16_t value) {
+    return WriteLittleEndian(value);
+  }
+  constexpr bool WriteI32LittleEndian(int32_t value) {
+    return WriteLittleEndian(value);
+  }
+  constexpr bool WriteI64LittleEndian(int64_t value) {
+    return WriteLittleEndian(value);
+  }
+  constexpr bool WriteI8NativeEndian(int8_t value) {
+    return WriteLittleEndian(value);
+  }
+  constexpr bool WriteI16NativeEndian(int16_t value) {
+    return WriteLittleEndian(value);
+  }
+  constexpr bool WriteI32NativeEndian(int32_t value) {
+    return WriteLittleEndian(value);
+  }
+  constexpr bool WriteI64NativeEndian(int64_t value) {
+    return WriteLittleEndian(value);
+  }
+
+  // For a SpanWriter over bytes, writes an IEEE 754 value of the named width
+  // and byte order. Returns false and does nothing if there is not enough
+  // space left.
+  constexpr bool WriteFloatBigEndian(float value) {
+    return WriteBigEndian(value);
+  }
+  constexpr bool WriteDoubleBigEndian(double value) {
+    return WriteBigEndian(value);
+  }
+  constexpr bool WriteFloatLittleEndian(float value) {
+    return WriteLittleEndian(value);
+  }
+  constexpr bool WriteDoubleLittleEndian(double value) {
+    return WriteLittleEndian(value);
+  }
+
+  // For a SpanWriter over bytes, writes `value` as an unsigned LEB128 varint.
+  // Returns false and does nothing if there is not enough space left.
+  constexpr bool WriteVarint(uint64_t value)
+    requires(std::same_as<T, uint8_t>)
+  {
+    uint8_t bytes[numerics::kMaxVarintSize];
+    size_t size = numerics::EncodeVarint(value, bytes);
+    return Write(span(bytes).first(size));
+  }
+
+  // For a SpanWriter over bytes, writes the size of `data` as a length of the
+  // named width and byte order, followed by `data` itself. Returns false and
+  // does nothing if there is not enough space left, or if the size of `data`
+  // does not fit in the length.
+  constexpr bool WriteU8LengthPrefixed(span<const uint8_t> data) {
+    return WriteLengthPrefixed<uint8_t>(/*big_endian=*/true, data);
+  }
+  constexpr bool WriteU16LengthPrefixedBigEndian(span<const uint8_t> data) {
+    return WriteLengthPrefixed<uint16_t>(/*big_endian=*/true, data);
+  }
+  constexpr bool WriteU32LengthPrefixedBigEndian(span<const uint8_t> data) {
+    return WriteLengthPrefixed<uint32_t>(/*big_endian=*/true, data);
+  }
+  constexpr bool WriteU16LengthPrefixedLittleEndian(span<const uint8_t> data) {
+    return WriteLengthPrefixed<uint16_t>(/*big_endian=*/false, data);
+  }
+  constexpr bool WriteU32LengthPrefixedLittleEndian(span<const uint8_t> data) {
+    return WriteLengthPrefixed<uint32_t>(/*big_endian=*/false, data);
+  }
+
+  // Like the above, where the length is an unsigned LEB128 varint.
+  constexpr bool WriteVarintLengthPrefixed(span<const uint8_t> data)
+    requires(std::same_as<T, uint8_t>)
+  {
+    if (numerics::VarintSize(data.size()) + data.size() > remaining()) {
+      return false;
+    }
+    WriteVarint(data.size());
+    Write(data);
+    return true;
+  }
+
+  // Returns the number of objects remaining to be written to the original
+  // span.
+  constexpr size_t remaining() const { return buf_.size(); }
+  // Returns the objects that have not yet been written to, as a span.
+  constexpr span<T> remaining_span() const { return buf_; }
+
+  // Returns the number of objects written (or skipped) in the original span.
+  constexpr size_t num_written() const { return original_size_ - buf_.size(); }
+
+ private:
+  template <internal::SpanField... Fields>
+  constexpr bool WriteFields(bool big_endian, Fields... fields) {
+    constexpr size_t kSize = (sizeof(Fields) + ...);
+    std::optional<span<T, kSize>> bytes = Skip<kSize>();
+    if (!bytes) {
+      return false;
+    }
+    uint8_t* field = bytes->data();
+    // SAFETY: `bytes` holds kSize bytes, the sum of the sizes of the fields,
+    // so each field's bytes lie within it.
+    ((internal::EncodeSpanField(
+          fields, big_endian,
+          UNSAFE_BUFFERS(span<uint8_t, sizeof(Fields)>(field, sizeof(Fields)))),
+      field = UNSAFE_BUFFERS(field + sizeof(Fields))),
+     ...);
+    return true;
+  }
+
+  template <typename Length>
+  constexpr bool WriteLengthPrefixed(bool big_endian,
+                                     span<const uint8_t> data)
+    requires(std::same_as<T, uint8_t>)
+  {
+    if (data.size() > std::numeric_limits<Length>::max() ||
+        sizeof(Length) + data.size() > remaining()) {
+      return false;
+    }
+    WriteFields(big_endian, static_cast<Length>(data.size()));
+    Write(data);
+    return true;
+  }
+
+  span<T> buf_;
+  size_t original_size_;
+};
+
+template <class T, size_t N>
+SpanWriter(span<T, N>) -> SpanWriter<T>;
+
+}  // namespace base
+
+#endif  // MINI_CHROMIUM_BASE_CONTAINERS_SPAN_WRITER_H_
@@ -0,0 +1,125 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MINI_CHROMIUM_BASE_FILES_ASYNC_FILE_READER_H_
+#define MINI_CHROMIUM_BASE_FILES_ASYNC_FILE_READER_H_
+
+#include "build/build_config.h"
+
+#if BUILDFLAG(IS_POSIX)
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "base/containers/heap_array.h"
+
+namespace base {
+
+class FilePath;
+
+// AsyncFileReader reads many whole files concurrently, so that reading N small
+// files costs about one round trip of device latency rather than N of them.
+//
+// On Linux kernels that support it, requests are batched into an io_uring:
+// the opens for every queued file go to the kernel in a single system call,
+// and the reads that follow each open are batched the same way, using
+// registered buffers for small files. Elsewhere, or if io_uring is
+// unavailable or disallowed, a pool of worker threads performs ordinary
+// blocking reads.
+//
+//   std::unique_ptr<AsyncFileReader> reader = AsyncFileReader::Create();
+//   for (const FilePath& path : paths) {
+//     reader->ReadFile(path);
+//   }
+//   reader->Submit();
+//   std::vector<AsyncFileReader::Completion> completions;
+//   while (reader->pending() > 0) {
+//     reader->WaitForCompletions(&completions, 1);
+//     ...
+//   }
+//
+// Callers with their own event loop can instead watch completion_fd() and
+// call PollCompletions() whenever it becomes readable.
+//
+// An AsyncFileReader must be used from a single thread. Destroying it waits for
+// the reads that the kernel or the workers have already started, and discards
+// their results.
+class AsyncFileReader {
+ public:
+  struct Options {
+    // The maximum number of files being read at once. Further requests are
+    // queued until earlier ones finish.
+    size_t max_in_flight = 128;
+
+    // The number of worker threads used when io_uring is not used.
+    size_t worker_threads = 8;
+
+    // Files larger than this fail with EFBIG.
+    size_t max_file_size = 1u << 30;
+
+    // Whether io_uring may be used where available.
+    bool allow_io_uring = true;
+  };
+
+  struct Completion {
+    // The value returned by the ReadFile() call for this file.
+    uint64_t request_id = 0;
+
+    // 0 on success, or an errno value.
+    int error = 0;
+
+    // The contents of the file on success.
+    HeapArray<uint8_t> contents;
+  };
+
+  static std::unique_ptr<AsyncFileReader> Create();
+  static std::unique_ptr<AsyncFileReader> Create(const Options& options);
+
+  AsyncFileReader(const AsyncFileReader&) = delete;
+  AsyncFileReader& operator=(const AsyncFileReader&) = delete;
+
+  virtual ~AsyncFileReader();
+
+  // Queues a read of the whole file at |path| and returns an identifier for
+  // it. Queued reads start at the next Submit(), or earlier if the batch
+  // fills up.
+  virtual uint64_t ReadFile(const FilePath& path) = 0;
+
+  // Hands all queued reads to the kernel or the worker threads.
+  virtual void Submit() = 0;
+
+  // Appends finished reads to |completions| without blocking, and returns how
+  // many were appended. This also advances reads that are between steps, so
+  // it must be called whenever completion_fd() is readable.
+  virtual size_t PollCompletions(std::vector<Completion>* completions) = 0;
+
+  // Like PollCompletions(), but blocks until at least |min_completions| reads
+  // have finished, or until every outstanding read has. Submits queued reads
+  // first.
+  virtual size_t WaitForCompletions(std::vector<Completion>* completions,
+                                    size_t min_completions) = 0;
+
+  // A descriptor that becomes readable when PollCompletions() has work to do.
+  // It may occasionally be readable when there is none.
+  virtual int completion_fd() const = 0;
+
+  // The number of reads requested whose completions have not yet been
+  // returned.
+  virtual size_t pending() const = 0;
+
+  // Whether this reader is backed by io_uring.
+  virtual bool UsesIoUring() const = 0;
+
+ protected:
+  AsyncFileReader();
+};
+
+}  // namespace base
+
+#endif  // BUILDFLAG(IS_POSIX)
+
+#endif  // MINI_CHROMIUM_BASE_FILES_ASYNC_FILE_READER_H_
@@ -0,0 +1,607 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/files/async_file_reader_io_uring_linux.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <deque>
+#include <string>
+#include <utility>
+
+#include "base/check.h"
+#include "base/check_op.h"
+#include "base/files/file_path.h"
+#include "base/files/scoped_file.h"
+#include "base/memory/free_deleter.h"
+#include "base/posix/eintr_wrapper.h"
+
+namespace base {
+namespace internal {
+
+namespace {
+
+// Files up to this size are read into registered (pre-pinned) buffers, which
+// saves the kernel from pinning and unpinning the destination pages for every
+// read, and are then copied out.
+constexpr size_t kFixedBufferSize = 64 * 1024;
+constexpr size_t kMaxFixedBuffers = 32;
+
+// The largest single read submitted; the SQE length field is 32 bits.
+constexpr size_t kMaxReadChunk = 1 << 30;
+
+// The submission queue holds, for each request in flight, at most one open or
+// read, plus a close for each request that finished since the last submit.
+constexpr size_t kMaxSubmissionQueueEntries = 4096;
+
+// Each SQE's user_data holds a Request pointer with the operation in the low
+// bits. Close operations carry no Request.
+enum Operation : uint64_t {
+  kOpen = 1,
+  kRead = 2,
+  kClose = 3,
+};
+constexpr uint64_t kOperationMask = 7;
+
+int IoUringSetup(unsigned entries, io_uring_params* params) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int IoUringEnter(int ring_fd,
+                 unsigned to_submit,
+                 unsigned min_complete,
+                 unsigned flags) {
+  return static_cast<int>(syscall(__NR_io_uring_enter, ring_fd, to_submit,
+                                  min_complete, flags, nullptr, 0));
+}
+
+int IoUringRegister(int ring_fd,
+                    unsigned opcode,
+                    const void* arg,
+                    unsigned nr_args) {
+  return static_cast<int>(
+      syscall(__NR_io_uring_register, ring_fd, opcode, arg, nr_args));
+}
+
+// The ring indices are shared with the kernel.
+uint32_t LoadAcquire(uint32_t* index) {
+  return std::atomic_ref<uint32_t>(*index).load(std::memory_order_acquire);
+}
+
+void StoreRelease(uint32_t* index, uint32_t value) {
+  std::atomic_ref<uint32_t>(*index).store(value, std::memory_order_release);
+}
+
+bool SupportsRequiredOperations(int ring_fd, bool* supports_read_fixed) {
+  constexpr unsigned kProbeOps = 256;
+  std::unique_ptr<io_uring_probe, FreeDeleter> probe(
+      static_cast<io_uring_probe*>(calloc(
+          1, sizeof(io_uring_probe) + kProbeOps * sizeof(io_uring_probe_op))));
+  if (IoUringRegister(ring_fd, IORING_REGISTER_PROBE, probe.get(),
+                      kProbeOps) != 0) {
+    return false;
+  }
+  auto supported = [&probe](unsigned op) {
+    return op <= probe->last_op &&
+           (probe->ops[op].flags & IO_URING_OP_SUPPORTED);
+  };
+  *supports_read_fixed = supported(IORING_OP_READ_FIXED);
+  return supported(IORING_OP_OPENAT) && supported(IORING_OP_READ) &&
+         supported(IORING_OP_CLOSE);
+}
+
+class IoUringFileReader : public AsyncFileReader {
+ public:
+  explicit IoUringFileReader(const Options& options)
+      : max_in_flight_(std::min(options.max_in_flight,
+                                kMaxSubmissionQueueEntries / 2)),
+        max_file_size_(options.max_file_size) {}
+
+  ~IoUringFileReader() override {
+    if (!ring_fd_.is_valid()) {
+      return;
+    }
+
+    // The kernel may still be writing into buffers owned by in-flight
+    // requests, so wait for every operation before tearing down.
+    shutting_down_ = true;
+    waiting_.clear();
+    SubmitPending();
+    while (in_flight_operations_ > 0) {
+      int result = IoUringEnter(ring_fd_.get(), 0, 1, IORING_ENTER_GETEVENTS);
+      PCHECK(result >= 0 || errno == EINTR) << "io_uring_enter";
+      ProcessCompletions();
+      SubmitPending();
+    }
+
+    ring_fd_.reset();
+    if (fixed_buffers_) {
+      munmap(fixed_buffers_, fixed_buffer_count_ * kFixedBufferSize);
+    }
+    munmap(sqes_, sqes_size_);
+    if (cq_ring_ != sq_ring_) {
+      munmap(cq_ring_, cq_ring_size_);
+    }
+    munmap(sq_ring_, sq_ring_size_);
+  }
+
+  bool Initialize() {
+    io_uring_params params = {};
+    unsigned entries = static_cast<unsigned>(
+        std::bit_ceil(std::max<size_t>(2 * max_in_flight_, 8)));
+    ScopedFD ring_fd(IoUringSetup(entries, &params));
+    if (!ring_fd.is_valid()) {
+      return false;
+    }
+    // Without IORING_FEAT_NODROP (Linux 5.5), completions that do not fit in
+    // the completion queue would be lost.
+    bool supports_read_fixed = false;
+    if (!(params.features & IORING_FEAT_NODROP) ||
+        !SupportsRequiredOperations(ring_fd.get(), &supports_read_fixed)) {
+      return false;
+    }
+
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    cq_ring_size_ =
+        params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (single_mmap) {
+      sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+    }
+    void* sq_ring =
+        mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE,
+             MAP_SHARED | MAP_POPULATE, ring_fd.get(), IORING_OFF_SQ_RING);
+    if (sq_ring == MAP_FAILED) {
+      return false;
+    }
+    sq_ring_ = static_cast<uint8_t*>(sq_ring);
+    cq_ring_ = sq_ring_;
+    if (!single_mmap) {
+      void* cq_ring =
+          mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE,
+               MAP_SHARED | MAP_POPULATE, ring_fd.get(), IORING_OFF_CQ_RING);
+      if (cq_ring == MAP_FAILED) {
+        munmap(sq_ring_, sq_ring_size_);
+        return false;
+      }
+      cq_ring_ = static_cast<uint8_t*>(cq_ring);
+    }
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, ring_fd.get(),
+                      IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+      if (cq_ring_ != sq_ring_) {
+        munmap(cq_ring_, cq_ring_size_);
+      }
+      munmap(sq_ring_, sq_ring_size_);
+      return false;
+    }
+    sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+    sq_head_ = reinterpret_cast<uint32_t*>(sq_ring_ + params.sq_off.head);
+    sq_tail_ = reinterpret_cast<uint32_t*>(sq_ring_ + params.sq_off.tail);
+    sq_array_ = reinterpret_cast<uint32_t*>(sq_ring_ + params.sq_off.array);
+    sq_mask_ = *reinterpret_cast<uint32_t*>(sq_ring_ + params.sq_off.ring_mask);
+    sq_entries_ = params.sq_entries;
+    sq_local_tail_ = *sq_tail_;
+    cq_head_ = reinterpret_cast<uint32_t*>(cq_ring_ + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<uint32_t*>(cq_ring_ + params.cq_off.tail);
+    cq_mask_ = *reinterpret_cast<uint32_t*>(cq_ring_ + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe*>(cq_ring_ + params.cq_off.cqes);
+    ring_fd_ = std::move(ring_fd);
+
+    event_fd_.reset(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK));
+    if (!event_fd_.is_valid()) {
+      return false;
+    }
+    int event_fd = event_fd_.get();
+    if (IoUringRegister(ring_fd_.get(), IORING_REGISTER_EVENTFD, &event_fd,
+                        1) != 0) {
+      return false;
+    }
+
+    if (supports_read_fixed) {
+      RegisterFixedBuffers();
+    }
+    return true;
+  }
+
+  uint64_t ReadFile(const FilePath& path) override {
+    auto request = std::make_unique<Request>();
+    request->request_id = next_request_id_++;
+    request->path = path.value();
+    uint64_t request_id = request->request_id;
+    ++pending_;
+    if (active_requests_ < max_in_flight_) {
+      PrepareOpen(std::move(request));
+    } else {
+      waiting_.push_back(std::move(request));
+    }
+    return request_id;
+  }
+
+  void Submit() override { SubmitPending(); }
+
+  size_t PollCompletions(std::vector<Completion>* completions) override {
+    uint64_t count;
+    HANDLE_EINTR(read(event_fd_.get(), &count, sizeof(count)));
+    ProcessCompletions();
+    SubmitPending();
+
+    size_t taken = completed_.size();
+    for (Completion& completion : completed_) {
+      completions->push_back(std::move(completion));
+    }
+    completed_.clear();
+    pending_ -= taken;
+    return taken;
+  }
+
+  size_t WaitForCompletions(std::vector<Completion>* completions,
+                            size_t min_completions) override {
+    size_t taken = PollCompletions(completions);
+    while (taken < min_completions && pending_ > 0) {
+      DCHECK_GT(in_flight_operations_, 0u);
+      int result = IoUringEnter(ring_fd_.get(), 0, 1, IORING_ENTER_GETEVENTS);
+      PCHECK(result >= 0 || errno == EINTR) << "io_uring_enter";
+      taken += PollCompletions(completions);
+    }
+    return taken;
+  }
+
+  int completion_fd() const override { return event_fd_.get(); }
+
+  size_t pending() const override { return pending_; }
+
+  bool UsesIoUring() const override { return true; }
+
+ private:
+  struct Request {
+    uint64_t request_id = 0;
+    std::string path;
+    int fd = -1;
+    size_t size = 0;
+    size_t bytes_read = 0;
+    // Whether `size` came from fstat(). Otherwise it is the size of the
+    // buffer, which grows as the file is read.
+    bool size_known = true;
+    int fixed_buffer = -1;
+    HeapArray<uint8_t> contents;
+  };
+
+  void RegisterFixedBuffers() {
+    size_t count = std::min(kMaxFixedBuffers, max_in_flight_);
+    void* buffers = mmap(nullptr, count * kFixedBufferSize,
+                         PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+                         -1, 0);
+    if (buffers == MAP_FAILED) {
+      return;
+    }
+    struct iovec iov[kMaxFixedBuffers];
+    for (size_t i = 0; i < count; ++i) {
+      iov[i].iov_base = static_cast<uint8_t*>(buffers) + i * kFixedBufferSize;
+      iov[i].iov_len = kFixedBufferSize;
+    }
+    // Registration pins the pages and can fail against RLIMIT_MEMLOCK on older
+    // kernels, in which case every read goes straight to its destination.
+    if (IoUringRegister(ring_fd_.get(), IORING_REGISTER_BUFFERS, iov,
+                        static_cast<unsigned>(count)) != 0) {
+      munmap(buffers, count * kFixedBufferSize);
+      return;
+    }
+    fixed_buffers_ = static_cast<uint8_t*>(buffers);
+    fixed_buffer_count_ = count;
+    for (size_t i = count; i > 0; --i) {
+      free_fixed_buffers_.push_back(static_cast<int>(i - 1));
+    }
+  }
+
+  uint8_t* FixedBuffer(int index) {
+    return fixed_buffers_ + static_cast<size_t>(index) * kFixedBufferSize;
+  }
+
+  io_uring_sqe* GetSqe() {
+    if (sq_local_tail_ - LoadAcquire(sq_head_) == sq_entries_) {
+      SubmitPending();
+    }
+    uint32_t index = sq_local_tail_ & sq_mask_;
+    io_uring_sqe* sqe = &sqes_[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sq_array_[index] = index;
+    ++sq_local_tail_;
+    ++to_submit_;
+    ++in_flight_operations_;
+    return sqe;
+  }
+
+  void PrepareOpen(std::unique_ptr<Request> request) {
+    ++active_requests_;
+    io_uring_sqe* sqe = GetSqe();
+    sqe->opcode = IORING_OP_OPENAT;
+    sqe->fd = AT_FDCWD;
+    sqe->addr = reinterpret_cast<uint64_t>(request->path.c_str());
+    sqe->open_flags = O_RDONLY | O_CLOEXEC;
+    sqe->user_data = reinterpret_cast<uint64_t>(request.release()) | kOpen;
+  }
+
+  void PrepareRead(std::unique_ptr<Request> request) {
+    io_uring_sqe* sqe = GetSqe();
+    size_t length = std::min(request->size - request->bytes_read,
+                             kMaxReadChunk);
+    if (request->fixed_buffer >= 0) {
+      sqe->opcode = IORING_OP_READ_FIXED;
+      sqe->addr = reinterpret_cast<uint64_t>(
+          FixedBuffer(request->fixed_buffer) + request->bytes_read);
+      sqe->buf_index = static_cast<uint16_t>(request->fixed_buffer);
+    } else {
+      sqe->opcode = IORING_OP_READ;
+      sqe->addr = reinterpret_cast<uint64_t>(request->contents.data() +
+                                             request->bytes_read);
+    }
+    sqe->fd = request->fd;
+    sqe->off = request->bytes_read;
+    sqe->len = static_cast<uint32_t>(length);
+    sqe->user_data = reinterpret_cast<uint64_t>(request.release()) | kRead;
+  }
+
+  void PrepareClose(int fd) {
+    io_uring_sqe* sqe = GetSqe();
+    sqe->opcode = IORING_OP_CLOSE;
+    sqe->fd = fd;
+    sqe->user_data = kClose;
+  }
+
+  // Hands prepared SQEs to the kernel. This never processes completions, so
+  // it is safe to call from the completion handlers.
+  void SubmitPending() {
+    if (to_submit_ == 0) {
+      return;
+    }
+    StoreRelease(sq_tail_, sq_local_tail_);
+    while (to_submit_ > 0) {
+      int result = IoUringEnter(ring_fd_.get(), to_submit_, 0, 0);
+      if (result >= 0) {
+        to_submit_ -= static_cast<uint32_t>(result);
+        continue;
+      }
+      if (errno == EBUSY || errno == EAGAIN) {
+        // Older kernels refuse submissions while completions are backed up,
+        // so move them out of the ring to be handled later.
+        if (!StashCompletions()) {
+          IoUringEnter(ring_fd_.get(), 0, 1, IORING_ENTER_GETEVENTS);
+        }
+        continue;
+      }
+      PCHECK(errno == EINTR) << "io_uring_enter";
+    }
+  }
+
+  // Moves completions from the ring to |stashed_|. Returns true if there were
+  // any.
+  bool StashCompletions() {
+    uint32_t head = *cq_head_;
+    uint32_t tail = LoadAcquire(cq_tail_);
+    for (uint32_t i = head; i != tail; ++i) {
+      stashed_.push_back(cqes_[i & cq_mask_]);
+    }
+    StoreRelease(cq_head_, tail);
+    return head != tail;
+  }
+
+  void ProcessCompletions() {
+    while (true) {
+      StashCompletions();
+      if (stashed_.empty()) {
+        return;
+      }
+      std::vector<io_uring_cqe> batch;
+      batch.swap(stashed_);
+      for (const io_uring_cqe& cqe : batch) {
+        --in_flight_operations_;
+        Request* request =
+            reinterpret_cast<Request*>(cqe.user_data & ~kOperationMask);
+        switch (cqe.user_data & kOperationMask) {
+          case kOpen:
+            OnOpened(std::unique_ptr<Request>(request), cqe.res);
+            break;
+          case kRead:
+            OnRead(std::unique_ptr<Request>(request), cqe.res);
+            break;
+          case kClose:
+            break;
+        }
+      }
+    }
+  }
+
+  void OnOpened(std::unique_ptr<Request> request, int result) {
+    if (result < 0) {
+      Finish(std::move(request), -result);
+      return;
+    }
+    request->fd = result;
+    if (shutting_down_) {
+      Finish(std::move(request), ECANCELED);
+      return;
+    }
+
+    struct stat file_info;
+    if (fstat(request->fd, &file_info) != 0) {
+      Finish(std::move(request), errno);
+      return;
+    }
+    if (!S_ISREG(file_info.st_mode) || file_info.st_size <= 0) {
+      // Files of unknown size (procfs, pipes, devices) are read from the ring
+      // like any other, into a buffer that grows whenever a read fills it,
+      // until a read returns 0 or the file turns out to be too large.
+      request->size_known = false;
+      request->size = kFixedBufferSize <= max_file_size_
+                          ? kFixedBufferSize
+                          : max_file_size_ + 1;
+      request->contents = HeapArray<uint8_t>::Uninit(request->size);
+      PrepareRead(std::move(request));
+      return;
+    }
+    if (static_cast<uint64_t>(file_info.st_size) > max_file_size_) {
+      Finish(std::move(request), EFBIG);
+      return;
+    }
+
+    request->size = static_cast<size_t>(file_info.st_size);
+    if (request->size <= kFixedBufferSize && !free_fixed_buffers_.empty()) {
+      request->fixed_buffer = free_fixed_buffers_.back();
+      free_fixed_buffers_.pop_back();
+    } else {
+      request->contents = HeapArray<uint8_t>::Uninit(request->size);
+    }
+    PrepareRead(std::move(request));
+  }
+
+  void OnRead(std::unique_ptr<Request> request, int result) {
+    if (shutting_down_) {
+      Finish(std::move(request), ECANCELED);
+      return;
+    }
+    if (result == -EINTR || result == -EAGAIN) {
+      PrepareRead(std::move(request));
+      return;
+    }
+    if (result < 0) {
+      Finish(std::move(request), -result);
+      return;
+    }
+    if (result == 0) {
+      // The end of a file of unknown size, or the file shrank after fstat().
+      request->size = request->bytes_read;
+    }
+    request->bytes_read += static_cast<size_t>(result);
+    if (!request->size_known && request->bytes_read == request->size &&
+        result > 0) {
+      if (request->bytes_read > max_file_size_) {
+        Finish(std::move(request), EFBIG);
+        return;
+      }
+      GrowBuffer(request.get());
+    }
+    if (request->bytes_read < request->size) {
+      PrepareRead(std::move(request));
+      return;
+    }
+
+    if (request->fixed_buffer >= 0) {
+      request->contents = HeapArray<uint8_t>::CopiedFrom(
+          make_span(FixedBuffer(request->fixed_buffer), request->size));
+    } else if (request->size < request->contents.size()) {
+      request->contents = HeapArray<uint8_t>::CopiedFrom(
+          request->contents.first(request->size));
+    }
+    Finish(std::move(request), 0);
+  }
+
+  // Doubles the buffer of a file of unknown size that filled it, up to one
+  // byte more than `max_file_size_`, which is how a file that is too large
+  // shows itself.
+  void GrowBuffer(Request* request) {
+    size_t bytes_read = request->bytes_read;
+    request->size =
+        bytes_read + std::min(bytes_read, max_file_size_ - bytes_read + 1);
+    auto grown = HeapArray<uint8_t>::Uninit(request->size);
+    grown.first(bytes_read).copy_from(request->contents.first(bytes_read));
+    request->contents = std::move(grown);
+  }
+
+  void Finish(std::unique_ptr<Request> request, int error) {
+    if (request->fixed_buffer >= 0) {
+      free_fixed_buffers_.push_back(request->fixed_buffer);
+    }
+    if (request->fd >= 0) {
+      if (shutting_down_) {
+        IGNORE_EINTR(close(request->fd));
+      } else {
+        PrepareClose(request->fd);
+      }
+    }
+    --active_requests_;
+
+    Completion completion;
+    completion.request_id = request->request_id;
+    completion.error = error;
+    if (!error) {
+      completion.contents = std::move(request->contents);
+    }
+    completed_.push_back(std::move(completion));
+
+    while (active_requests_ < max_in_flight_ && !waiting_.empty()) {
+      std::unique_ptr<Request> next = std::move(waiting_.front());
+      waiting_.pop_front();
+      PrepareOpen(std::move(next));
+    }
+  }
+
+  const size_t max_in_flight_;
+  const size_t max_file_size_;
+
+  ScopedFD ring_fd_;
+  ScopedFD event_fd_;
+
+  uint8_t* sq_ring_ = nullptr;
+  size_t sq_ring_size_ = 0;
+  uint8_t* cq_ring_ = nullptr;
+  size_t cq_ring_size_ = 0;
+  io_uring_sqe* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+
+  uint32_t* sq_head_ = nullptr;
+  uint32_t* sq_tail_ = nullptr;
+  uint32_t* sq_array_ = nullptr;
+  uint32_t sq_mask_ = 0;
+  uint32_t sq_entries_ = 0;
+  uint32_t sq_local_tail_ = 0;
+  uint32_t to_submit_ = 0;
+  uint32_t* cq_head_ = nullptr;
+  uint32_t* cq_tail_ = nullptr;
+  uint32_t cq_mask_ = 0;
+  io_uring_cqe* cqes_ = nullptr;
+
+  uint8_t* fixed_buffers_ = nullptr;
+  size_t fixed_buffer_count_ = 0;
+  std::vector<int> free_fixed_buffers_;
+
+  uint64_t next_request_id_ = 1;
+  size_t pending_ = 0;
+  size_t active_requests_ = 0;
+  size_t in_flight_operations_ = 0;
+  bool shutting_down_ = false;
+  std::deque<std::unique_ptr<Request>> waiting_;
+  std::vector<io_uring_cqe> stashed_;
+  std::vector<Completion> completed_;
+};
+
+}  // namespace
+
+std::unique_ptr<AsyncFileReader> CreateIoUringFileReader(
+    const AsyncFileReader::Options& options) {
+  auto reader = std::make_unique<IoUringFileReader>(options);
+  if (!reader->Initialize()) {
+    return nullptr;
+  }
+  return reader;
+}
+
+}  // namespace internal
+}  // namespace base
@@ -0,0 +1,24 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MINI_CHROMIUM_BASE_FILES_ASYNC_FILE_READER_IO_URING_LINUX_H_
+#define MINI_CHROMIUM_BASE_FILES_ASYNC_FILE_READER_IO_URING_LINUX_H_
+
+#include <memory>
+
+#include "base/files/async_file_reader.h"
+
+namespace base {
+namespace internal {
+
+// Returns an io_uring-backed AsyncFileReader, or nullptr if the running kernel
+// does not support the required io_uring operations (Linux 5.6 and later) or
+// io_uring is disabled.
+std::unique_ptr<AsyncFileReader> CreateIoUringFileReader(
+    const AsyncFileReader::Options& options);
+
+}  // namespace internal
+}  // namespace base
+
+#endif  // MINI_CHROMIUM_BASE_FILES_ASYNC_FILE_READER_IO_URING_LINUX_H_
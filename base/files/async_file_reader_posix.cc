@@ -0,0 +1,329 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/files/async_file_reader.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <deque>
+#include <string>
+#include <utility>
+
+#include "base/check.h"
+#include "base/check_op.h"
+#include "base/files/file_path.h"
+#include "base/files/scoped_file.h"
+#include "base/posix/eintr_wrapper.h"
+#include "base/synchronization/condition_variable.h"
+#include "base/synchronization/lock.h"
+
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) || BUILDFLAG(IS_ANDROID)
+#include <sys/eventfd.h>
+
+#include "base/files/async_file_reader_io_uring_linux.h"
+#endif
+
+namespace base {
+
+namespace {
+
+// Signals a pollable descriptor: an eventfd where available, otherwise the
+// read end of a non-blocking pipe.
+class CompletionNotifier {
+ public:
+  CompletionNotifier() {
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) || BUILDFLAG(IS_ANDROID)
+    read_fd_.reset(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK));
+    PCHECK(read_fd_.is_valid()) << "eventfd";
+#else
+    int fds[2];
+    PCHECK(pipe(fds) == 0) << "pipe";
+    read_fd_.reset(fds[0]);
+    write_fd_.reset(fds[1]);
+    for (int fd : fds) {
+      PCHECK(fcntl(fd, F_SETFD, FD_CLOEXEC) == 0);
+      PCHECK(fcntl(fd, F_SETFL, O_NONBLOCK) == 0);
+    }
+#endif
+  }
+
+  CompletionNotifier(const CompletionNotifier&) = delete;
+  CompletionNotifier& operator=(const CompletionNotifier&) = delete;
+
+  int fd() const { return read_fd_.get(); }
+
+  void Notify() {
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) || BUILDFLAG(IS_ANDROID)
+    uint64_t value = 1;
+    HANDLE_EINTR(write(read_fd_.get(), &value, sizeof(value)));
+#else
+    char value = 0;
+    HANDLE_EINTR(write(write_fd_.get(), &value, sizeof(value)));
+#endif
+  }
+
+  void Drain() {
+    char buffer[64];
+    while (HANDLE_EINTR(read(read_fd_.get(), buffer, sizeof(buffer))) > 0) {
+    }
+  }
+
+ private:
+  ScopedFD read_fd_;
+#if !(BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) || BUILDFLAG(IS_ANDROID))
+  ScopedFD write_fd_;
+#endif
+};
+
+// The first buffer for a file whose size is not known in advance. It doubles
+// each time it fills.
+constexpr size_t kInitialBufferSize = 64 * 1024;
+
+// Reads files on a fixed pool of worker threads with blocking system calls.
+class ThreadPoolFileReader : public AsyncFileReader {
+ public:
+  explicit ThreadPoolFileReader(const Options& options)
+      : max_file_size_(options.max_file_size),
+        work_available_(&lock_),
+        work_finished_(&lock_) {
+    size_t thread_count =
+        std::max<size_t>(1, std::min(options.worker_threads,
+                                     options.max_in_flight));
+    threads_.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; ++i) {
+      pthread_t thread;
+      int result = pthread_create(&thread, nullptr, &ThreadMain, this);
+      CHECK_EQ(result, 0) << "pthread_create";
+      threads_.push_back(thread);
+    }
+  }
+
+  ~ThreadPoolFileReader() override {
+    {
+      AutoLock auto_lock(lock_);
+      shutting_down_ = true;
+      queued_.clear();
+      work_available_.Broadcast();
+    }
+    for (pthread_t thread : threads_) {
+      pthread_join(thread, nullptr);
+    }
+  }
+
+  uint64_t ReadFile(const FilePath& path) override {
+    uint64_t request_id = next_request_id_++;
+    batch_.push_back({request_id, path.value()});
+    ++pending_;
+    return request_id;
+  }
+
+  void Submit() override {
+    if (batch_.empty()) {
+      return;
+    }
+    AutoLock auto_lock(lock_);
+    for (Request& request : batch_) {
+      queued_.push_back(std::move(request));
+    }
+    batch_.clear();
+    work_available_.Broadcast();
+  }
+
+  size_t PollCompletions(std::vector<Completion>* completions) override {
+    notifier_.Drain();
+    AutoLock auto_lock(lock_);
+    return TakeCompletedLocked(completions);
+  }
+
+  size_t WaitForCompletions(std::vector<Completion>* completions,
+                            size_t min_completions) override {
+    Submit();
+    notifier_.Drain();
+    AutoLock auto_lock(lock_);
+    size_t taken = 0;
+    while (true) {
+      taken += TakeCompletedLocked(completions);
+      if (taken >= min_completions || pending_ == 0) {
+        return taken;
+      }
+      work_finished_.Wait();
+    }
+  }
+
+  int completion_fd() const override { return notifier_.fd(); }
+
+  size_t pending() const override { return pending_; }
+
+  bool UsesIoUring() const override { return false; }
+
+ private:
+  struct Request {
+    uint64_t request_id;
+    std::string path;
+  };
+
+  static void* ThreadMain(void* arg) {
+    static_cast<ThreadPoolFileReader*>(arg)->RunWorker();
+    return nullptr;
+  }
+
+  void RunWorker() {
+    AutoLock auto_lock(lock_);
+    while (true) {
+      while (queued_.empty() && !shutting_down_) {
+        work_available_.Wait();
+      }
+      if (shutting_down_) {
+        return;
+      }
+      Request request = std::move(queued_.front());
+      queued_.pop_front();
+
+      Completion completion;
+      completion.request_id = request.request_id;
+      {
+        AutoUnlock auto_unlock(lock_);
+        completion.error = ReadWholeFile(request.path, &completion.contents);
+      }
+      completed_.push_back(std::move(completion));
+      work_finished_.Signal();
+      notifier_.Notify();
+    }
+  }
+
+  // Returns 0 or an errno value.
+  int ReadWholeFile(const std::string& path, HeapArray<uint8_t>* contents) {
+    ScopedFD fd(HANDLE_EINTR(open(path.c_str(), O_RDONLY | O_CLOEXEC)));
+    if (!fd.is_valid()) {
+      return errno;
+    }
+    struct stat file_info;
+    if (fstat(fd.get(), &file_info) != 0) {
+      return errno;
+    }
+    if (!S_ISREG(file_info.st_mode) || file_info.st_size <= 0) {
+      return ReadToEnd(fd.get(), contents);
+    }
+    if (static_cast<uint64_t>(file_info.st_size) > max_file_size_) {
+      return EFBIG;
+    }
+
+    size_t size = static_cast<size_t>(file_info.st_size);
+    HeapArray<uint8_t> buffer = HeapArray<uint8_t>::Uninit(size);
+    size_t bytes_read = 0;
+    while (bytes_read < size) {
+      ssize_t result = HANDLE_EINTR(pread(fd.get(), buffer.data() + bytes_read,
+                                          size - bytes_read,
+                                          static_cast<off_t>(bytes_read)));
+      if (result < 0) {
+        return errno;
+      }
+      if (result == 0) {
+        // The file shrank after fstat().
+        break;
+      }
+      bytes_read += static_cast<size_t>(result);
+    }
+    *contents = bytes_read == size
+                    ? std::move(buffer)
+                    : HeapArray<uint8_t>::CopiedFrom(buffer.first(bytes_read));
+    return 0;
+  }
+
+  // Reads a file whose size fstat() does not give (procfs, pipes, devices)
+  // into a growing buffer, until end of file or until it has read more than
+  // `max_file_size_` bytes. Returns 0 or an errno value.
+  int ReadToEnd(int fd, HeapArray<uint8_t>* contents) {
+    HeapArray<uint8_t> buffer = HeapArray<uint8_t>::Uninit(
+        max_file_size_ < kInitialBufferSize ? max_file_size_ + 1
+                                            : kInitialBufferSize);
+    size_t bytes_read = 0;
+    while (true) {
+      if (bytes_read == buffer.size()) {
+        // Grow up to one byte more than the limit, which is how a file that
+        // is too large shows itself.
+        auto grown = HeapArray<uint8_t>::Uninit(
+            bytes_read + std::min(bytes_read, max_file_size_ - bytes_read + 1));
+        grown.first(bytes_read).copy_from(buffer.first(bytes_read));
+        buffer = std::move(grown);
+      }
+      ssize_t result = HANDLE_EINTR(read(fd, buffer.data() + bytes_read,
+                                         buffer.size() - bytes_read));
+      if (result < 0) {
+        return errno;
+      }
+      if (result == 0) {
+        break;
+      }
+      bytes_read += static_cast<size_t>(result);
+      if (bytes_read > max_file_size_) {
+        return EFBIG;
+      }
+    }
+    *contents = bytes_read == buffer.size()
+                    ? std::move(buffer)
+                    : HeapArray<uint8_t>::CopiedFrom(buffer.first(bytes_read));
+    return 0;
+  }
+
+  size_t TakeCompletedLocked(std::vector<Completion>* completions) {
+    lock_.AssertAcquired();
+    size_t taken = completed_.size();
+    for (Completion& completion : completed_) {
+      completions->push_back(std::move(completion));
+    }
+    completed_.clear();
+    pending_ -= taken;
+    return taken;
+  }
+
+  const size_t max_file_size_;
+  CompletionNotifier notifier_;
+  std::vector<pthread_t> threads_;
+
+  // Accessed only on the owning thread.
+  std::vector<Request> batch_;
+  uint64_t next_request_id_ = 1;
+  size_t pending_ = 0;
+
+  Lock lock_;
+  ConditionVariable work_available_;
+  ConditionVariable work_finished_;
+  std::deque<Request> queued_;
+  std::vector<Completion> completed_;
+  bool shutting_down_ = false;
+};
+
+}  // namespace
+
+AsyncFileReader::AsyncFileReader() = default;
+
+AsyncFileReader::~AsyncFileReader() = default;
+
+// static
+std::unique_ptr<AsyncFileReader> AsyncFileReader::Create() {
+  return Create(Options());
+}
+
+// static
+std::unique_ptr<AsyncFileReader> AsyncFileReader::Create(
+    const Options& options) {
+  DCHECK_GT(options.max_in_flight, 0u);
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) || BUILDFLAG(IS_ANDROID)
+  if (options.allow_io_uring) {
+    if (std::unique_ptr<AsyncFileReader> reader =
+            internal::CreateIoUringFileReader(options)) {
+      return reader;
+    }
+  }
+#endif
+  return std::make_unique<ThreadPoolFileReader>(options);
+}
+
+}  // namespace base
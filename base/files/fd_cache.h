@@ -0,0 +1,143 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MINI_CHROMIUM_BASE_FILES_FD_CACHE_H_
+#define MINI_CHROMIUM_BASE_FILES_FD_CACHE_H_
+
+#include "build/build_config.h"
+
+#if BUILDFLAG(IS_POSIX)
+
+#include <stddef.h>
+
+#include <chrono>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+#include "base/files/file_path.h"
+#include "base/files/scoped_file.h"
+#include "base/synchronization/lock.h"
+
+namespace base {
+
+// FDCache keeps recently used files open, so that code which repeatedly opens
+// the same small set of files (configuration, state, lock files) pays for
+// open(), close() and the path lookup only once.
+//
+//   FDCache::Handle handle = cache.Open(config_path, O_RDONLY);
+//   if (!handle.is_valid()) {
+//     return false;
+//   }
+//   pread(handle.get(), ...);
+//
+// Descriptors are keyed by path and open flags (O_CLOEXEC is always added)
+// and shared: every Handle for the same key refers to the same open file
+// description, including its file offset, so callers should use pread() and
+// pwrite() rather than read() and write(). O_TRUNC and O_EXCL are not
+// meaningful for a shared descriptor and must not be used; with O_CREAT, new
+// files are created with mode 0666 as modified by the umask.
+//
+// At most |max_open_files| descriptors are kept; beyond that the least
+// recently used are closed. A Handle keeps its descriptor open after the
+// cache evicts it, so the budget covers the cache's own references only.
+//
+// A cached descriptor is checked when it is handed out, at most once per
+// |revalidation_interval|, by comparing the device and inode numbers from
+// fstat() of the descriptor and stat() of the path. If the path no longer
+// names the open file, because the file was deleted or replaced, the path is
+// reopened. Call Invalidate() to notice changes sooner.
+//
+// FDCache is thread-safe.
+class FDCache {
+ public:
+  struct Options {
+    size_t max_open_files = 64;
+    std::chrono::steady_clock::duration revalidation_interval =
+        std::chrono::seconds(1);
+  };
+
+  // A shared reference to a cached descriptor.
+  class Handle {
+   public:
+    Handle();
+    Handle(const Handle& that);
+    Handle(Handle&& that) noexcept;
+    ~Handle();
+    Handle& operator=(const Handle& that);
+    Handle& operator=(Handle&& that) noexcept;
+
+    bool is_valid() const { return !!fd_; }
+    int get() const { return fd_ ? fd_->get() : -1; }
+
+    // Returns a separately owned duplicate of the descriptor, for APIs that
+    // take a ScopedFD. The duplicate still shares the file offset.
+    ScopedFD Duplicate() const;
+
+   private:
+    friend class FDCache;
+
+    explicit Handle(std::shared_ptr<const ScopedFD> fd);
+
+    std::shared_ptr<const ScopedFD> fd_;
+  };
+
+  FDCache();
+  explicit FDCache(const Options& options);
+
+  FDCache(const FDCache&) = delete;
+  FDCache& operator=(const FDCache&) = delete;
+
+  ~FDCache();
+
+  // Returns a handle to |path| opened with |flags|, opening it if it is not
+  // cached. Returns an invalid handle, with errno set, if open() fails.
+  Handle Open(const FilePath& path, int flags);
+
+  // Drops the cached descriptors for |path|, whatever their flags.
+  void Invalidate(const FilePath& path);
+
+  // Drops every cached descriptor.
+  void Clear();
+
+  // The number of cached descriptors.
+  size_t size() const;
+
+ private:
+  struct Key {
+    bool operator==(const Key& that) const = default;
+
+    FilePath path;
+    int flags;
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
+  struct Entry {
+    Key key;
+    std::shared_ptr<const ScopedFD> fd;
+    std::chrono::steady_clock::time_point validated_at;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  void EraseLocked(EntryList::iterator it);
+  void EvictLocked();
+
+  const Options options_;
+
+  mutable Lock lock_;
+
+  // Most recently used first.
+  EntryList entries_;
+  std::unordered_map<Key, EntryList::iterator, KeyHash> index_;
+};
+
+}  // namespace base
+
+#endif  // BUILDFLAG(IS_POSIX)
+
+#endif  // MINI_CHROMIUM_BASE_FILES_FD_CACHE_H_
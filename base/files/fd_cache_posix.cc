@@ -0,0 +1,168 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/files/fd_cache.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <iterator>
+#include <utility>
+
+#include "base/check.h"
+#include "base/check_op.h"
+#include "base/posix/eintr_wrapper.h"
+
+namespace base {
+
+namespace {
+
+// Returns whether `path` still names the file open as `fd`. Comparing device
+// and inode numbers notices the file being deleted or replaced by any means
+// (rename(), or moving it away and creating a new one), even if the old file
+// is still linked elsewhere.
+bool PathNamesFile(const FilePath& path, int fd) {
+  struct stat path_info;
+  struct stat fd_info;
+  return stat(path.value().c_str(), &path_info) == 0 &&
+         fstat(fd, &fd_info) == 0 && path_info.st_dev == fd_info.st_dev &&
+         path_info.st_ino == fd_info.st_ino;
+}
+
+}  // namespace
+
+// FDCache::Handle ------------------------------------------------------------
+
+FDCache::Handle::Handle() = default;
+
+FDCache::Handle::Handle(const Handle& that) = default;
+
+FDCache::Handle::Handle(Handle&& that) noexcept = default;
+
+FDCache::Handle::Handle(std::shared_ptr<const ScopedFD> fd)
+    : fd_(std::move(fd)) {}
+
+FDCache::Handle::~Handle() = default;
+
+FDCache::Handle& FDCache::Handle::operator=(const Handle& that) = default;
+
+FDCache::Handle& FDCache::Handle::operator=(Handle&& that) noexcept = default;
+
+ScopedFD FDCache::Handle::Duplicate() const {
+  if (!fd_) {
+    return ScopedFD();
+  }
+  return ScopedFD(HANDLE_EINTR(fcntl(fd_->get(), F_DUPFD_CLOEXEC, 0)));
+}
+
+// FDCache --------------------------------------------------------------------
+
+size_t FDCache::KeyHash::operator()(const Key& key) const {
+  return FilePathHash()(key.path) ^
+         (static_cast<size_t>(key.flags) * 0x9e3779b97f4a7c15ull);
+}
+
+FDCache::FDCache() : FDCache(Options()) {}
+
+FDCache::FDCache(const Options& options) : options_(options) {
+  DCHECK_GT(options_.max_open_files, 0u);
+}
+
+FDCache::~FDCache() = default;
+
+FDCache::Handle FDCache::Open(const FilePath& path, int flags) {
+  DCHECK(!(flags & (O_TRUNC | O_EXCL)));
+  Key key = {path, flags | O_CLOEXEC};
+  const auto now = std::chrono::steady_clock::now();
+
+  std::shared_ptr<const ScopedFD> cached_fd;
+  {
+    AutoLock auto_lock(lock_);
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+      Entry& entry = *it->second;
+      if (now - entry.validated_at < options_.revalidation_interval) {
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return Handle(entry.fd);
+      }
+      cached_fd = entry.fd;
+    }
+  }
+
+  if (cached_fd) {
+    // Revalidate without holding the lock too, since stat() of a path can be
+    // as slow as open().
+    bool valid = PathNamesFile(path, cached_fd->get());
+    AutoLock auto_lock(lock_);
+    auto it = index_.find(key);
+    // If the entry was dropped or replaced meanwhile, open the file afresh.
+    if (it != index_.end() && it->second->fd == cached_fd) {
+      if (valid) {
+        it->second->validated_at = now;
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return Handle(std::move(cached_fd));
+      }
+      EraseLocked(it->second);
+    }
+  }
+
+  // Open without holding the lock, so that a slow open() does not stall
+  // lookups of other files.
+  ScopedFD fd(HANDLE_EINTR(open(path.value().c_str(), key.flags, 0666)));
+  if (!fd.is_valid()) {
+    return Handle();
+  }
+  auto shared_fd = std::make_shared<const ScopedFD>(std::move(fd));
+
+  AutoLock auto_lock(lock_);
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    // Another thread opened the same file meanwhile; keep the cached one.
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return Handle(it->second->fd);
+  }
+  entries_.push_front({std::move(key), shared_fd, now});
+  index_.emplace(entries_.front().key, entries_.begin());
+  EvictLocked();
+  return Handle(std::move(shared_fd));
+}
+
+void FDCache::Invalidate(const FilePath& path) {
+  AutoLock auto_lock(lock_);
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    auto next = std::next(it);
+    if (it->key.path == path) {
+      EraseLocked(it);
+    }
+    it = next;
+  }
+}
+
+void FDCache::Clear() {
+  AutoLock auto_lock(lock_);
+  index_.clear();
+  entries_.clear();
+}
+
+size_t FDCache::size() const {
+  AutoLock auto_lock(lock_);
+  return entries_.size();
+}
+
+void FDCache::EraseLocked(EntryList::iterator it) {
+  lock_.AssertAcquired();
+  index_.erase(it->key);
+  entries_.erase(it);
+}
+
+void FDCache::EvictLocked() {
+  lock_.AssertAcquired();
+  while (entries_.size() > options_.max_open_files) {
+    EraseLocked(std::prev(entries_.end()));
+  }
+}
+
+}  // namespace base
@@ -0,0 +1,138 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MINI_CHROMIUM_BASE_FILES_FILE_ENUMERATOR_H_
+#define MINI_CHROMIUM_BASE_FILES_FILE_ENUMERATOR_H_
+
+#include "build/build_config.h"
+
+#if BUILDFLAG(IS_POSIX)
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/stat.h>
+
+#include <memory>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/files/scoped_file.h"
+
+namespace base {
+
+// A class for enumerating the files in a provided path. The order of the
+// results is not guaranteed.
+//
+// Directories are opened relative to their parent's descriptor with openat()
+// and read in large batches (getdents64() on Linux), and the type of each
+// entry comes from the directory entry itself where the file system provides
+// it, so walking a tree needs no stat() calls unless GetInfo() is used. With
+// |thread_count| > 0, subdirectories are read concurrently by that many
+// threads owned by the enumerator, while Next() consumes their results.
+//
+// Symbolic links are never followed. They are reported as files, and are not
+// recursed into even when they point at directories. Directories that cannot
+// be opened are skipped.
+//
+// Example:
+//
+//   base::FileEnumerator e(my_dir, /*recursive=*/true,
+//                          base::FileEnumerator::FILES);
+//   for (base::FilePath name = e.Next(); !name.empty(); name = e.Next()) {
+//     ...
+//   }
+class FileEnumerator {
+ public:
+  // Note: copy & assign supported.
+  class FileInfo {
+   public:
+    FileInfo();
+    ~FileInfo();
+
+    bool IsDirectory() const;
+
+    // The name of the file. This will not include any path information. This
+    // is in contrast to the value returned by FileEnumerator.Next() which
+    // includes the |root_path| passed into the FileEnumerator constructor.
+    FilePath GetName() const;
+
+    int64_t GetSize() const;
+
+    const struct stat& stat() const { return stat_; }
+
+   private:
+    friend class FileEnumerator;
+
+    struct stat stat_;
+    FilePath filename_;
+  };
+
+  enum FileType {
+    FILES = 1 << 0,
+    DIRECTORIES = 1 << 1,
+  };
+
+  // |root_path| is the starting directory to search for. It may or may not
+  // end in a slash. If |recursive| is true, this will enumerate all matches
+  // in any subdirectories matched as well. |file_type| is a bitmask of
+  // FileType values.
+  FileEnumerator(const FilePath& root_path, bool recursive, int file_type);
+  FileEnumerator(const FilePath& root_path,
+                 bool recursive,
+                 int file_type,
+                 size_t thread_count);
+
+  FileEnumerator(const FileEnumerator&) = delete;
+  FileEnumerator& operator=(const FileEnumerator&) = delete;
+
+  ~FileEnumerator();
+
+  // Returns the next file or an empty string if there are no more results.
+  // The returned path will incorporate the |root_path| passed in the
+  // constructor: "<root_path>/file_name.txt". If the |root_path| is absolute,
+  // then so will be the result of Next().
+  FilePath Next();
+
+  // Returns info about the file last returned by Next(). This is the only
+  // operation that may stat() the file.
+  FileInfo GetInfo() const;
+
+ private:
+  struct Directory;
+  struct Entry;
+  struct Batch;
+  struct PendingDirectory;
+  class Workers;
+
+  // Reads |directory| into |batch|, adding the subdirectories to be visited
+  // to |subdirectories|. |buffer| is scratch space for the directory reads.
+  static void ReadDirectory(const PendingDirectory& directory,
+                            bool recursive,
+                            int file_type,
+                            std::vector<uint8_t>* buffer,
+                            Batch* batch,
+                            std::vector<PendingDirectory>* subdirectories);
+
+  // Makes |batch_| the next batch of results. Returns false when the
+  // enumeration is finished.
+  bool NextBatch();
+
+  const bool recursive_;
+  const int file_type_;
+
+  // Used only without worker threads.
+  std::vector<PendingDirectory> pending_;
+  std::vector<uint8_t> buffer_;
+
+  std::unique_ptr<Workers> workers_;
+
+  std::unique_ptr<Batch> batch_;
+  size_t next_entry_ = 0;
+};
+
+}  // namespace base
+
+#endif  // BUILDFLAG(IS_POSIX)
+
+#endif  // MINI_CHROMIUM_BASE_FILES_FILE_ENUMERATOR_H_
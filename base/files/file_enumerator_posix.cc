@@ -0,0 +1,385 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/files/file_enumerator.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <deque>
+#include <utility>
+
+#include "base/check.h"
+#include "base/check_op.h"
+#include "base/posix/eintr_wrapper.h"
+#include "base/synchronization/condition_variable.h"
+#include "base/synchronization/lock.h"
+
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) || BUILDFLAG(IS_ANDROID)
+#include <sys/syscall.h>
+#endif
+
+namespace base {
+
+namespace {
+
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) || BUILDFLAG(IS_ANDROID)
+// The record format returned by getdents64(), which glibc does not declare.
+struct LinuxDirent64 {
+  uint64_t d_ino;
+  int64_t d_off;
+  unsigned short d_reclen;
+  unsigned char d_type;
+  char d_name[];
+};
+
+// Large enough for several hundred typical entries per system call.
+constexpr size_t kDirectoryBufferSize = 64 * 1024;
+#endif
+
+// The most batches that worker threads may queue ahead of Next(). Each batch
+// holds its directory open, so this also bounds the descriptors in use.
+constexpr size_t kMaxQueuedBatches = 256;
+
+bool IsDotOrDotDot(const char* name) {
+  return name[0] == '.' &&
+         (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'));
+}
+
+}  // namespace
+
+// An open directory. It stays open while any of its entries are being
+// returned or any of its subdirectories are waiting to be opened with openat().
+struct FileEnumerator::Directory {
+  explicit Directory(ScopedFD fd) : fd(std::move(fd)) {}
+
+  const ScopedFD fd;
+};
+
+struct FileEnumerator::Entry {
+  FilePath path;
+
+  // The offset of the final component within |path|.
+  size_t name_offset;
+
+  bool is_directory;
+};
+
+// The results from one directory.
+struct FileEnumerator::Batch {
+  std::shared_ptr<const Directory> directory;
+  std::vector<Entry> entries;
+};
+
+struct FileEnumerator::PendingDirectory {
+  // Null for the root, which is opened by |path|.
+  std::shared_ptr<const Directory> parent;
+  FilePath path;
+  size_t name_offset;
+};
+
+// Worker threads that read directories ahead of Next().
+class FileEnumerator::Workers {
+ public:
+  Workers(PendingDirectory root,
+          bool recursive,
+          int file_type,
+          size_t thread_count)
+      : recursive_(recursive),
+        file_type_(file_type),
+        work_available_(&lock_),
+        batch_available_(&lock_) {
+    pending_.push_back(std::move(root));
+    threads_.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; ++i) {
+      pthread_t thread;
+      int result = pthread_create(&thread, nullptr, &ThreadMain, this);
+      CHECK_EQ(result, 0) << "pthread_create";
+      threads_.push_back(thread);
+    }
+  }
+
+  Workers(const Workers&) = delete;
+  Workers& operator=(const Workers&) = delete;
+
+  ~Workers() {
+    {
+      AutoLock auto_lock(lock_);
+      shutting_down_ = true;
+      work_available_.Broadcast();
+    }
+    for (pthread_t thread : threads_) {
+      pthread_join(thread, nullptr);
+    }
+  }
+
+  // Returns the next non-empty batch, or nullptr once every directory has
+  // been read.
+  std::unique_ptr<Batch> Take() {
+    AutoLock auto_lock(lock_);
+    while (batches_.empty() && !IsFinishedLocked()) {
+      batch_available_.Wait();
+    }
+    if (batches_.empty()) {
+      return nullptr;
+    }
+    std::unique_ptr<Batch> batch = std::move(batches_.front());
+    batches_.pop_front();
+    work_available_.Signal();
+    return batch;
+  }
+
+ private:
+  static void* ThreadMain(void* arg) {
+    static_cast<Workers*>(arg)->Run();
+    return nullptr;
+  }
+
+  bool IsFinishedLocked() const { return pending_.empty() && active_ == 0; }
+
+  void Run() {
+    std::vector<uint8_t> buffer;
+    std::vector<PendingDirectory> subdirectories;
+
+    AutoLock auto_lock(lock_);
+    while (true) {
+      while (!shutting_down_ &&
+             (pending_.empty() || batches_.size() >= kMaxQueuedBatches)) {
+        if (IsFinishedLocked()) {
+          return;
+        }
+        work_available_.Wait();
+      }
+      if (shutting_down_) {
+        return;
+      }
+
+      PendingDirectory directory = std::move(pending_.back());
+      pending_.pop_back();
+      ++active_;
+      auto batch = std::make_unique<Batch>();
+      {
+        AutoUnlock auto_unlock(lock_);
+        ReadDirectory(directory, recursive_, file_type_, &buffer, batch.get(),
+                      &subdirectories);
+        directory.parent.reset();
+      }
+      --active_;
+
+      if (!subdirectories.empty()) {
+        for (PendingDirectory& subdirectory : subdirectories) {
+          pending_.push_back(std::move(subdirectory));
+        }
+        subdirectories.clear();
+        work_available_.Broadcast();
+      }
+      if (!batch->entries.empty()) {
+        batches_.push_back(std::move(batch));
+        batch_available_.Signal();
+      }
+      if (IsFinishedLocked()) {
+        work_available_.Broadcast();
+        batch_available_.Broadcast();
+      }
+    }
+  }
+
+  const bool recursive_;
+  const int file_type_;
+  std::vector<pthread_t> threads_;
+
+  Lock lock_;
+  ConditionVariable work_available_;
+  ConditionVariable batch_available_;
+  std::vector<PendingDirectory> pending_;
+  std::deque<std::unique_ptr<Batch>> batches_;
+  size_t active_ = 0;
+  bool shutting_down_ = false;
+};
+
+// FileEnumerator::FileInfo ----------------------------------------------------
+
+FileEnumerator::FileInfo::FileInfo() {
+  memset(&stat_, 0, sizeof(stat_));
+}
+
+FileEnumerator::FileInfo::~FileInfo() = default;
+
+bool FileEnumerator::FileInfo::IsDirectory() const {
+  return S_ISDIR(stat_.st_mode);
+}
+
+FilePath FileEnumerator::FileInfo::GetName() const {
+  return filename_;
+}
+
+int64_t FileEnumerator::FileInfo::GetSize() const {
+  return stat_.st_size;
+}
+
+// FileEnumerator --------------------------------------------------------------
+
+FileEnumerator::FileEnumerator(const FilePath& root_path,
+                               bool recursive,
+                               int file_type)
+    : FileEnumerator(root_path, recursive, file_type, 0) {}
+
+FileEnumerator::FileEnumerator(const FilePath& root_path,
+                               bool recursive,
+                               int file_type,
+                               size_t thread_count)
+    : recursive_(recursive), file_type_(file_type) {
+  DCHECK(file_type & (FILES | DIRECTORIES));
+  PendingDirectory root = {nullptr, root_path, 0};
+  if (thread_count > 0) {
+    workers_ = std::make_unique<Workers>(std::move(root), recursive,
+                                         file_type, thread_count);
+  } else {
+    pending_.push_back(std::move(root));
+  }
+}
+
+FileEnumerator::~FileEnumerator() = default;
+
+FilePath FileEnumerator::Next() {
+  while (!batch_ || next_entry_ == batch_->entries.size()) {
+    if (!NextBatch()) {
+      return FilePath();
+    }
+  }
+  return batch_->entries[next_entry_++].path;
+}
+
+FileEnumerator::FileInfo FileEnumerator::GetInfo() const {
+  DCHECK(batch_ && next_entry_ > 0);
+  const Entry& entry = batch_->entries[next_entry_ - 1];
+  const char* name = entry.path.value().c_str() + entry.name_offset;
+
+  FileInfo info;
+  info.filename_ = FilePath(FilePath::StringType(name));
+  if (fstatat(batch_->directory->fd.get(), name, &info.stat_,
+              AT_SYMLINK_NOFOLLOW) != 0) {
+    // The file is gone; report what the directory entry said.
+    memset(&info.stat_, 0, sizeof(info.stat_));
+    info.stat_.st_mode = entry.is_directory ? S_IFDIR : S_IFREG;
+  }
+  return info;
+}
+
+bool FileEnumerator::NextBatch() {
+  batch_.reset();
+  next_entry_ = 0;
+  if (workers_) {
+    batch_ = workers_->Take();
+    return !!batch_;
+  }
+
+  while (!pending_.empty()) {
+    PendingDirectory directory = std::move(pending_.back());
+    pending_.pop_back();
+    auto batch = std::make_unique<Batch>();
+    ReadDirectory(directory, recursive_, file_type_, &buffer_, batch.get(),
+                  &pending_);
+    if (!batch->entries.empty()) {
+      batch_ = std::move(batch);
+      return true;
+    }
+  }
+  return false;
+}
+
+// static
+void FileEnumerator::ReadDirectory(
+    const PendingDirectory& directory,
+    bool recursive,
+    int file_type,
+    std::vector<uint8_t>* buffer,
+    Batch* batch,
+    std::vector<PendingDirectory>* subdirectories) {
+  int fd;
+  if (directory.parent) {
+    fd = HANDLE_EINTR(
+        openat(directory.parent->fd.get(),
+               directory.path.value().c_str() + directory.name_offset,
+               O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC));
+  } else {
+    fd = HANDLE_EINTR(open(directory.path.value().c_str(),
+                           O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+  }
+  if (fd < 0) {
+    return;
+  }
+  auto open_directory = std::make_shared<const Directory>(ScopedFD(fd));
+  batch->directory = open_directory;
+
+  auto add_entry = [&](const char* name, unsigned char d_type) {
+    if (IsDotOrDotDot(name)) {
+      return;
+    }
+    bool is_directory;
+    if (d_type == DT_UNKNOWN) {
+      // Some file systems do not report types in directory entries.
+      struct stat file_info;
+      if (fstatat(fd, name, &file_info, AT_SYMLINK_NOFOLLOW) != 0) {
+        return;
+      }
+      is_directory = S_ISDIR(file_info.st_mode);
+    } else {
+      is_directory = d_type == DT_DIR;
+    }
+    bool wanted = file_type & (is_directory ? DIRECTORIES : FILES);
+    bool descend = is_directory && recursive;
+    if (!wanted && !descend) {
+      return;
+    }
+
+    FilePath::StringType component(name);
+    FilePath path = directory.path.Append(component);
+    size_t name_offset = path.value().length() - component.length();
+    if (descend) {
+      subdirectories->push_back({open_directory, path, name_offset});
+    }
+    if (wanted) {
+      batch->entries.push_back({std::move(path), name_offset, is_directory});
+    }
+  };
+
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) || BUILDFLAG(IS_ANDROID)
+  buffer->resize(kDirectoryBufferSize);
+  while (true) {
+    long bytes = HANDLE_EINTR(
+        syscall(SYS_getdents64, fd, buffer->data(), buffer->size()));
+    if (bytes <= 0) {
+      break;
+    }
+    for (long offset = 0; offset < bytes;) {
+      const LinuxDirent64* dirent =
+          reinterpret_cast<const LinuxDirent64*>(buffer->data() + offset);
+      add_entry(dirent->d_name, dirent->d_type);
+      offset += dirent->d_reclen;
+    }
+  }
+#else
+  // readdir() on a duplicate, since closedir() closes the descriptor it was
+  // given and |fd| is still needed for openat().
+  int dir_fd = HANDLE_EINTR(dup(fd));
+  if (dir_fd < 0) {
+    return;
+  }
+  DIR* dir = fdopendir(dir_fd);
+  if (!dir) {
+    IGNORE_EINTR(close(dir_fd));
+    return;
+  }
+  while (const struct dirent* dirent = readdir(dir)) {
+    add_entry(dirent->d_name, dirent->d_type);
+  }
+  closedir(dir);
+#endif
+}
+
+}  // namespace base
@@ -5,7 +5,10 @@
 #include "base/files/file_path.h"
 
 #include <ctype.h>
+#include <stdint.h>
 
+#include <algorithm>
+#include <functional>
 #include <ostream>
 
 #include "base/check.h"
@@ -28,6 +31,7 @@ const FilePath::CharType FilePath::kParentDirectory[] = FILE_PATH_LITERAL("..");
 const FilePath::CharType FilePath::kExtensionSeparator = FILE_PATH_LITERAL('.');
 
 typedef FilePath::StringType StringType;
+typedef FilePath::StringViewType StringViewType;
 
 namespace {
 
@@ -38,7 +42,7 @@ const FilePath::CharType kStringTerminator = FILE_PATH_LITERAL('\0');
 // otherwise returns npos.  This can only be true on Windows, when a pathname
 // begins with a letter followed by a colon.  On other platforms, this always
 // returns npos.
-StringType::size_type FindDriveLetter(const StringType& path) {
+StringType::size_type FindDriveLetter(StringViewType path) {
 #if defined(FILE_PATH_USES_DRIVE_LETTERS)
   // This is dependent on an ASCII-based character set, but that's a
   // reasonable assumption.  iswalpha can be too inclusive here.
@@ -52,8 +56,7 @@ StringType::size_type FindDriveLetter(const StringType& path) {
 }
 
 #if defined(FILE_PATH_USES_DRIVE_LETTERS)
-bool EqualDriveLetterCaseInsensitive(const StringType& a,
-                                     const StringType& b) {
+bool EqualDriveLetterCaseInsensitive(StringViewType a, StringViewType b) {
   size_t a_letter_pos = FindDriveLetter(a);
   size_t b_letter_pos = FindDriveLetter(b);
 
@@ -63,13 +66,11 @@ bool EqualDriveLetterCaseInsensitive(const StringType& a,
   if (::tolower(a[0]) != ::tolower(b[0]))
     return false;
 
-  StringType a_rest(a.substr(a_letter_pos + 1));
-  StringType b_rest(b.substr(b_letter_pos + 1));
-  return a_rest == b_rest;
+  return a.substr(a_letter_pos + 1) == b.substr(b_letter_pos + 1);
 }
 #endif  // defined(FILE_PATH_USES_DRIVE_LETTERS)
 
-bool IsPathAbsolute(const StringType& path) {
+bool IsPathAbsolute(StringViewType path) {
 #if defined(FILE_PATH_USES_DRIVE_LETTERS)
   StringType::size_type letter = FindDriveLetter(path);
   if (letter != StringType::npos) {
@@ -86,6 +87,45 @@ bool IsPathAbsolute(const StringType& path) {
 #endif  // FILE_PATH_USES_DRIVE_LETTERS
 }
 
+StringViewType TruncateAtNul(StringViewType path) {
+  return path.substr(0, path.find(kStringTerminator));
+}
+
+StringViewType::size_type FindLastSeparator(StringViewType path) {
+  return path.find_last_of(StringViewType(
+      FilePath::kSeparators, std::size(FilePath::kSeparators) - 1));
+}
+
+// Returns the length of |path| once trailing separators are removed, by the
+// rules described at FilePath::StripTrailingSeparatorsInternal().
+StringViewType::size_type StrippedLength(StringViewType path) {
+  // If there is no drive letter, start will be 1, which will prevent stripping
+  // the leading separator if there is only one separator.  If there is a drive
+  // letter, start will be set appropriately to prevent stripping the first
+  // separator following the drive letter, if a separator immediately follows
+  // the drive letter.
+  StringViewType::size_type start = FindDriveLetter(path) + 2;
+
+  StringViewType::size_type length = path.length();
+  StringViewType::size_type last_stripped = StringViewType::npos;
+  for (StringViewType::size_type pos = path.length();
+       pos > start && FilePath::IsSeparator(path[pos - 1]);
+       --pos) {
+    // If the string only has two separators and they're at the beginning,
+    // don't strip them, unless the string began with more than two separators.
+    if (pos != start + 1 || last_stripped == start + 2 ||
+        !FilePath::IsSeparator(path[start - 1])) {
+      length = pos - 1;
+      last_stripped = pos;
+    }
+  }
+  return length;
+}
+
+StringViewType StripTrailingSeparators(StringViewType path) {
+  return path.substr(0, StrippedLength(path));
+}
+
 }  // namespace
 
 FilePath::FilePath() {
@@ -94,12 +134,17 @@ FilePath::FilePath() {
 FilePath::FilePath(const FilePath& that) : path_(that.path_) {
 }
 
+FilePath::FilePath(FilePath&& that) noexcept = default;
+
 FilePath::FilePath(const StringType& path) : path_(path) {
   StringType::size_type nul_pos = path_.find(kStringTerminator);
   if (nul_pos != StringType::npos)
     path_.erase(nul_pos, StringType::npos);
 }
 
+FilePath::FilePath(FilePathView path) : path_(path.value()) {
+}
+
 FilePath::~FilePath() {
 }
 
@@ -108,6 +153,8 @@ FilePath& FilePath::operator=(const FilePath& that) {
   return *this;
 }
 
+FilePath& FilePath::operator=(FilePath&& that) noexcept = default;
+
 bool FilePath::operator==(const FilePath& that) const {
 #if defined(FILE_PATH_USES_DRIVE_LETTERS)
   return EqualDriveLetterCaseInsensitive(this->path_, that.path_);
@@ -135,97 +182,46 @@ bool FilePath::IsSeparator(CharType character) {
   return false;
 }
 
-// libgen's dirname and basename aren't guaranteed to be thread-safe and aren't
-// guaranteed to not modify their input strings, and in fact are implemented
-// differently in this regard on different platforms.  Don't use them, but
-// adhere to their behavior.
 FilePath FilePath::DirName() const {
-  FilePath new_path(path_);
-  new_path.StripTrailingSeparatorsInternal();
-
-  // The drive letter, if any, always needs to remain in the output.  If there
-  // is no drive letter, as will always be the case on platforms which do not
-  // support drive letters, letter will be npos, or -1, so the comparisons and
-  // resizes below using letter will still be valid.
-  StringType::size_type letter = FindDriveLetter(new_path.path_);
-
-  StringType::size_type last_separator = new_path.path_.find_last_of(
-      kSeparators, StringType::npos, std::size(kSeparators) - 1);
-  if (last_separator == StringType::npos) {
-    // path_ is in the current directory.
-    new_path.path_.resize(letter + 1);
-  } else if (last_separator == letter + 1) {
-    // path_ is in the root directory.
-    new_path.path_.resize(letter + 2);
-  } else if (last_separator == letter + 2 &&
-             IsSeparator(new_path.path_[letter + 1])) {
-    // path_ is in "//" (possibly with a drive letter); leave the double
-    // separator intact indicating alternate root.
-    new_path.path_.resize(letter + 3);
-  } else if (last_separator != 0) {
-    // path_ is somewhere else, trim the basename.
-    new_path.path_.resize(last_separator);
-  }
-
-  new_path.StripTrailingSeparatorsInternal();
-  if (!new_path.path_.length())
-    new_path.path_ = kCurrentDirectory;
-
-  return new_path;
+  return FilePath(FilePathView(*this).DirName());
 }
 
 FilePath FilePath::BaseName() const {
-  FilePath new_path(path_);
-  new_path.StripTrailingSeparatorsInternal();
-
-  // The drive letter, if any, is always stripped.
-  StringType::size_type letter = FindDriveLetter(new_path.path_);
-  if (letter != StringType::npos) {
-    new_path.path_.erase(0, letter + 1);
-  }
-
-  // Keep everything after the final separator, but if the pathname is only
-  // one character and it's a separator, leave it alone.
-  StringType::size_type last_separator = new_path.path_.find_last_of(
-      kSeparators, StringType::npos, std::size(kSeparators) - 1);
-  if (last_separator != StringType::npos &&
-      last_separator < new_path.path_.length() - 1) {
-    new_path.path_.erase(0, last_separator + 1);
-  }
-
-  return new_path;
+  return FilePath(FilePathView(*this).BaseName());
 }
 
 StringType FilePath::FinalExtension() const {
-  StringType base(BaseName().value());
-  // Special case "." and ".."
-  if (base == FilePath::kCurrentDirectory || base == FilePath::kParentDirectory)
-    return StringType();
-  const StringType::size_type dot = base.rfind(FilePath::kExtensionSeparator);
-  if (dot == StringType::npos)
-    return StringType();
-
-  return base.substr(dot, StringType::npos);
+  return StringType(FilePathView(*this).FinalExtension());
 }
 
 FilePath FilePath::RemoveFinalExtension() const {
-  StringType extension = FinalExtension();
-  if (FinalExtension().empty())
-    return *this;
-  return FilePath(path_.substr(0, path_.size() - extension.size()));
+  return FilePath(FilePathView(*this).RemoveFinalExtension());
 }
 
 FilePath FilePath::Append(const StringType& component) const {
-  const StringType* appended = &component;
-  StringType without_nuls;
+  FilePath new_path;
+  new_path.path_.reserve(path_.length() + 1 + component.length());
+  new_path.path_ = path_;
+  new_path.AppendInPlace(component);
+  return new_path;
+}
 
-  StringType::size_type nul_pos = component.find(kStringTerminator);
-  if (nul_pos != StringType::npos) {
-    without_nuls = component.substr(0, nul_pos);
-    appended = &without_nuls;
-  }
+FilePath FilePath::Append(const FilePath& component) const {
+  return Append(component.value());
+}
 
-  DCHECK(!IsPathAbsolute(*appended));
+FilePath& FilePath::AppendInPlace(StringViewType component) {
+  component = TruncateAtNul(component);
+  DCHECK(!IsPathAbsolute(component));
+
+  // |component| may point into |path_|, which the appends below can
+  // reallocate.
+  std::less<const CharType*> less;
+  if (!component.empty() && !less(component.data(), path_.data()) &&
+      less(component.data(), path_.data() + path_.length())) {
+    StringType copy(component);
+    return AppendInPlace(copy);
+  }
 
   if (path_.compare(kCurrentDirectory) == 0) {
     // Append normally doesn't do any normalization, but as a special case,
@@ -235,32 +231,110 @@ FilePath FilePath::Append(const StringType& component) const {
     // it's likely in practice to wind up with FilePath objects containing
     // only kCurrentDirectory when calling DirName on a single relative path
     // component.
-    return FilePath(*appended);
+    path_.assign(component);
+    return *this;
   }
 
-  FilePath new_path(path_);
-  new_path.StripTrailingSeparatorsInternal();
+  StripTrailingSeparatorsInternal();
 
   // Don't append a separator if the path is empty (indicating the current
   // directory) or if the path component is empty (indicating nothing to
   // append).
-  if (appended->length() > 0 && new_path.path_.length() > 0) {
+  bool append_separator = false;
+  if (component.length() > 0 && path_.length() > 0) {
     // Don't append a separator if the path still ends with a trailing
     // separator after stripping (indicating the root directory).
-    if (!IsSeparator(new_path.path_[new_path.path_.length() - 1])) {
+    if (!IsSeparator(path_[path_.length() - 1])) {
       // Don't append a separator if the path is just a drive letter.
-      if (FindDriveLetter(new_path.path_) + 1 != new_path.path_.length()) {
-        new_path.path_.append(1, kSeparators[0]);
+      if (FindDriveLetter(path_) + 1 != path_.length()) {
+        append_separator = true;
       }
     }
   }
 
-  new_path.path_.append(*appended);
-  return new_path;
+  path_.reserve(path_.length() + append_separator + component.length());
+  if (append_separator) {
+    path_.append(1, kSeparators[0]);
+  }
+  path_.append(component);
+  return *this;
 }
 
-FilePath FilePath::Append(const FilePath& component) const {
-  return Append(component.value());
+FilePath& FilePath::AppendInPlace(FilePathView component) {
+  return AppendInPlace(component.value());
+}
+
+void FilePath::NormalizeLexically() {
+  if (path_.empty()) {
+    return;
+  }
+
+  // Components are copied down from |read| to |write|; |write| never passes
+  // |read|, so the path can be rewritten in its own buffer.
+  const StringType::size_type length = path_.length();
+  StringType::size_type letter = FindDriveLetter(path_);
+  StringType::size_type read = letter + 1;
+  StringType::size_type write = read;
+
+  StringType::size_type separators = 0;
+  while (read + separators < length && IsSeparator(path_[read + separators])) {
+    ++separators;
+  }
+  // Exactly two leading separators denote an alternate root; more than two
+  // are equivalent to one.
+  StringType::size_type root_separators =
+      separators == 2 ? 2 : std::min<StringType::size_type>(separators, 1);
+  for (StringType::size_type i = 0; i < root_separators; ++i) {
+    path_[write++] = kSeparators[0];
+  }
+  read += separators;
+  const StringType::size_type root_end = write;
+  const bool absolute = separators > 0;
+
+  while (read < length) {
+    StringType::size_type end = read;
+    while (end < length && !IsSeparator(path_[end])) {
+      ++end;
+    }
+    StringViewType component(path_.data() + read, end - read);
+
+    if (component == kParentDirectory) {
+      // Find the last component written so far.
+      StringType::size_type last = write;
+      while (last > root_end && !IsSeparator(path_[last - 1])) {
+        --last;
+      }
+      StringViewType previous(path_.data() + last, write - last);
+      if (!previous.empty() && previous != kParentDirectory) {
+        write = last > root_end ? last - 1 : last;
+        component = StringViewType();
+      } else if (absolute) {
+        // There is nothing above the root.
+        component = StringViewType();
+      }
+    } else if (component == kCurrentDirectory) {
+      component = StringViewType();
+    }
+
+    if (!component.empty()) {
+      if (write > root_end) {
+        path_[write++] = kSeparators[0];
+      }
+      StringType::traits_type::move(&path_[write], &path_[read],
+                                    component.length());
+      write += component.length();
+    }
+
+    read = end;
+    while (read < length && IsSeparator(path_[read])) {
+      ++read;
+    }
+  }
+
+  path_.resize(write);
+  if (path_.empty()) {
+    path_ = kCurrentDirectory;
+  }
 }
 
 bool FilePath::IsAbsolute() const {
@@ -268,25 +342,144 @@ bool FilePath::IsAbsolute() const {
 }
 
 void FilePath::StripTrailingSeparatorsInternal() {
-  // If there is no drive letter, start will be 1, which will prevent stripping
-  // the leading separator if there is only one separator.  If there is a drive
-  // letter, start will be set appropriately to prevent stripping the first
-  // separator following the drive letter, if a separator immediately follows
-  // the drive letter.
-  StringType::size_type start = FindDriveLetter(path_) + 2;
+  path_.resize(StrippedLength(path_));
+}
 
-  StringType::size_type last_stripped = StringType::npos;
-  for (StringType::size_type pos = path_.length();
-       pos > start && IsSeparator(path_[pos - 1]);
-       --pos) {
-    // If the string only has two separators and they're at the beginning,
-    // don't strip them, unless the string began with more than two separators.
-    if (pos != start + 1 || last_stripped == start + 2 ||
-        !IsSeparator(path_[start - 1])) {
-      path_.resize(pos - 1);
-      last_stripped = pos;
+FilePathView::FilePathView(StringViewType path) : path_(TruncateAtNul(path)) {
+}
+
+bool FilePathView::operator==(const FilePathView& that) const {
+#if defined(FILE_PATH_USES_DRIVE_LETTERS)
+  return EqualDriveLetterCaseInsensitive(path_, that.path_);
+#else  // defined(FILE_PATH_USES_DRIVE_LETTERS)
+  return path_ == that.path_;
+#endif  // defined(FILE_PATH_USES_DRIVE_LETTERS)
+}
+
+// libgen's dirname and basename aren't guaranteed to be thread-safe and aren't
+// guaranteed to not modify their input strings, and in fact are implemented
+// differently in this regard on different platforms.  Don't use them, but
+// adhere to their behavior.
+FilePathView FilePathView::DirName() const {
+  StringViewType path = StripTrailingSeparators(path_);
+
+  // The drive letter, if any, always needs to remain in the output.  If there
+  // is no drive letter, as will always be the case on platforms which do not
+  // support drive letters, letter will be npos, or -1, so the comparisons and
+  // substrings below using letter will still be valid.
+  StringViewType::size_type letter = FindDriveLetter(path);
+
+  StringViewType::size_type last_separator = FindLastSeparator(path);
+  if (last_separator == StringViewType::npos) {
+    // path_ is in the current directory.
+    path = path.substr(0, letter + 1);
+  } else if (last_separator == letter + 1) {
+    // path_ is in the root directory.
+    path = path.substr(0, letter + 2);
+  } else if (last_separator == letter + 2 &&
+             FilePath::IsSeparator(path[letter + 1])) {
+    // path_ is in "//" (possibly with a drive letter); leave the double
+    // separator intact indicating alternate root.
+    path = path.substr(0, letter + 3);
+  } else if (last_separator != 0) {
+    // path_ is somewhere else, trim the basename.
+    path = path.substr(0, last_separator);
+  }
+
+  path = StripTrailingSeparators(path);
+  if (path.empty()) {
+    path = FilePath::kCurrentDirectory;
+  }
+
+  FilePathView result;
+  result.path_ = path;
+  return result;
+}
+
+FilePathView FilePathView::BaseName() const {
+  StringViewType path = StripTrailingSeparators(path_);
+
+  // The drive letter, if any, is always stripped.
+  StringViewType::size_type letter = FindDriveLetter(path);
+  if (letter != StringViewType::npos) {
+    path.remove_prefix(letter + 1);
+  }
+
+  // Keep everything after the final separator, but if the pathname is only
+  // one character and it's a separator, leave it alone.
+  StringViewType::size_type last_separator = FindLastSeparator(path);
+  if (last_separator != StringViewType::npos &&
+      last_separator < path.length() - 1) {
+    path.remove_prefix(last_separator + 1);
+  }
+
+  FilePathView result;
+  result.path_ = path;
+  return result;
+}
+
+StringViewType FilePathView::FinalExtension() const {
+  StringViewType base = BaseName().path_;
+  // Special case "." and ".."
+  if (base == FilePath::kCurrentDirectory ||
+      base == FilePath::kParentDirectory) {
+    return StringViewType();
+  }
+  const StringViewType::size_type dot =
+      base.rfind(FilePath::kExtensionSeparator);
+  if (dot == StringViewType::npos) {
+    return StringViewType();
+  }
+
+  return base.substr(dot);
+}
+
+FilePathView FilePathView::RemoveFinalExtension() const {
+  StringViewType extension = FinalExtension();
+  FilePathView result;
+  result.path_ = path_.substr(0, path_.length() - extension.length());
+  return result;
+}
+
+bool FilePathView::IsAbsolute() const {
+  return IsPathAbsolute(path_);
+}
+
+size_t FilePathHash::operator()(FilePathView path) const {
+  StringViewType value = path.value();
+  uint64_t hash = 0;
+
+  // The drive letter compares case-insensitively, so it must hash that way.
+  StringViewType::size_type letter = FindDriveLetter(value);
+  if (letter != StringViewType::npos) {
+    hash = static_cast<uint64_t>(::tolower(value[0]));
+    value.remove_prefix(letter + 1);
+  }
+
+  // Leading separators are significant: one is the root, two an alternate
+  // root.
+  StringViewType::size_type separators = 0;
+  while (separators < value.length() &&
+         FilePath::IsSeparator(value[separators])) {
+    ++separators;
+  }
+  hash = (hash << 2) + std::min<StringViewType::size_type>(separators, 3);
+  value.remove_prefix(separators);
+
+  std::hash<StringViewType> component_hash;
+  while (!value.empty()) {
+    StringViewType::size_type end = 0;
+    while (end < value.length() && !FilePath::IsSeparator(value[end])) {
+      ++end;
+    }
+    hash = (hash ^ component_hash(value.substr(0, end))) *
+           0x9e3779b97f4a7c15ull;
+    while (end < value.length() && FilePath::IsSeparator(value[end])) {
+      ++end;
     }
+    value.remove_prefix(end);
   }
+  return static_cast<size_t>(hash ^ (hash >> 32));
 }
 
 }  // namespace base
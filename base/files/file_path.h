@@ -47,6 +47,9 @@
 // These methods do not function as mutators but instead return distinct
 // instances of FilePath objects, and are therefore safe to use on const
 // objects.  The objects themselves are safe to share between threads.
+// AppendInPlace is the one mutating counterpart, for building paths without
+// a new allocation per component, and FilePathView offers the inspection
+// methods without any allocation at all.
 //
 // To aid in initialization of FilePath objects from string literals, a
 // FILE_PATH_LITERAL macro is provided, which accounts for the difference
@@ -106,6 +109,7 @@
 
 #include <iosfwd>
 #include <string>
+#include <string_view>
 
 #include "build/build_config.h"
 
@@ -121,6 +125,8 @@
 
 namespace base {
 
+class FilePathView;
+
 // An abstraction to isolate users from the differences between native
 // pathnames on different platforms.
 class FilePath {
@@ -137,6 +143,7 @@ class FilePath {
 #endif  // BUILDFLAG(IS_WIN)
 
   typedef StringType::value_type CharType;
+  typedef std::basic_string_view<CharType> StringViewType;
 
   // Null-terminated array of separators used to separate components in
   // hierarchical paths.  Each character in this array is a valid separator,
@@ -155,9 +162,12 @@ class FilePath {
 
   FilePath();
   FilePath(const FilePath& that);
+  FilePath(FilePath&& that) noexcept;
   explicit FilePath(const StringType& path);
+  explicit FilePath(FilePathView path);
   ~FilePath();
   FilePath& operator=(const FilePath& that);
+  FilePath& operator=(FilePath&& that) noexcept;
 
   bool operator==(const FilePath& that) const;
 
@@ -207,6 +217,27 @@ class FilePath {
   [[nodiscard]] FilePath Append(const StringType& component) const;
   [[nodiscard]] FilePath Append(const FilePath& component) const;
 
+  // Like Append(), but modifies this object rather than returning a new one,
+  // so that building a path one component at a time reuses the same buffer.
+  // |component| may refer to this object's own path.
+  FilePath& AppendInPlace(StringViewType component);
+  FilePath& AppendInPlace(FilePathView component);
+
+  // Rewrites this path in place, in a single pass, into its lexically normal
+  // form: runs of separators are collapsed into one kSeparators[0] (keeping a
+  // leading pair, which denotes an alternate root), kCurrentDirectory
+  // components are removed, and each kParentDirectory component removes the
+  // component before it.  A kParentDirectory directly after the root is
+  // dropped, and leading kParentDirectory components of a relative path are
+  // kept.  Trailing separators are removed, and a non-empty path that becomes
+  // empty turns into kCurrentDirectory.  For example, "a/./b//../c/" becomes
+  // "a/c" and "/../x" becomes "/x".
+  //
+  // Like the other methods here this does not consult the file system, so
+  // where "b" is a symbolic link, "a/b/.." may not name the same file before
+  // and after normalization.
+  void NormalizeLexically();
+
   // Returns true if this FilePath contains an absolute path.  On Windows, an
   // absolute path begins with either a drive letter specification followed by
   // a separator character, or with two separator characters.  On POSIX
@@ -224,6 +255,58 @@ class FilePath {
   StringType path_;
 };
 
+// A non-owning reference to a pathname, with the same component semantics as
+// FilePath. DirName(), BaseName(), FinalExtension() and RemoveFinalExtension()
+// return views into the referenced string (or, for kCurrentDirectory, into
+// static storage) instead of allocating new paths, which suits loops that
+// inspect many paths without keeping the pieces:
+//
+// | for (const FilePath& path : paths) {
+// |   if (FilePathView(path).FinalExtension() == FILE_PATH_LITERAL(".log")) {
+// |     ...
+// |   }
+// | }
+//
+// Like std::string_view, a FilePathView must not outlive the string it refers
+// to. Convert to FilePath to keep a result.
+class FilePathView {
+ public:
+  typedef FilePath::CharType CharType;
+  typedef FilePath::StringViewType StringViewType;
+
+  constexpr FilePathView() = default;
+
+  // As with FilePath, the path is truncated at the first NUL.
+  explicit FilePathView(StringViewType path);
+
+  // Intentionally implicit, like std::string to std::string_view.
+  FilePathView(const FilePath& path) : path_(path.value()) {}
+
+  bool operator==(const FilePathView& that) const;
+
+  StringViewType value() const { return path_; }
+
+  bool empty() const { return path_.empty(); }
+
+  // These behave exactly as the FilePath methods of the same names.
+  [[nodiscard]] FilePathView DirName() const;
+  [[nodiscard]] FilePathView BaseName() const;
+  [[nodiscard]] StringViewType FinalExtension() const;
+  [[nodiscard]] FilePathView RemoveFinalExtension() const;
+  bool IsAbsolute() const;
+
+ private:
+  StringViewType path_;
+};
+
+// Hashes a path one component at a time, ignoring redundant separators, so
+// that hashing needs no normalized copy of the path.  Paths that compare equal
+// always hash equal, and "a//b/" hashes the same as "a/b".  Suitable for
+// std::unordered_map<FilePath, T, FilePathHash>.
+struct FilePathHash {
+  size_t operator()(FilePathView path) const;
+};
+
 }  // namespace base
 
 // Streams `file_path`'s value to a byte stream, converting from wide
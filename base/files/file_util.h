@@ -9,12 +9,51 @@
 
 #if BUILDFLAG(IS_POSIX)
 
+#include <stdint.h>
 #include <sys/types.h>
+#include <sys/uio.h>
+
+#include "base/containers/heap_array.h"
+#include "base/containers/span.h"
 
 namespace base {
 
+class FilePath;
+
 bool ReadFromFD(int fd, char* buffer, size_t bytes);
 
+// Reads the entire contents of the file at |path| into |contents|. For regular
+// files the buffer is sized from fstat() and filled with a single allocation;
+// files whose size is not known in advance (pipes, procfs) are read with a
+// growing buffer. Returns false, leaving |contents| untouched, on failure.
+bool ReadFileToBuffer(const FilePath& path, HeapArray<uint8_t>* contents);
+
+// Writes all of |data| to |fd|, retrying partial writes. Returns true on
+// success.
+bool WriteFileDescriptor(int fd, span<const uint8_t> data);
+
+// Replaces the file at |path| with |data| so that readers see either the old
+// or the new contents, never a partial write. The data is written to a
+// temporary file in the same directory, flushed with fsync(), and renamed
+// over |path|. The containing directory is then synced, where the file system
+// supports it, so that the rename itself is durable.
+// The new file is created with mode 0600. Returns true on success.
+bool WriteFileAtomically(const FilePath& path, span<const uint8_t> data);
+
+// Scatter/gather versions of ReadFromFD() and WriteFileDescriptor(). These
+// fill (or drain) every buffer in |iov| in order, retrying on EINTR and
+// resuming partial transfers mid-buffer. ReadvFromFD() returns false if EOF is
+// reached before all buffers are filled.
+bool ReadvFromFD(int fd, span<const struct iovec> iov);
+bool WritevToFD(int fd, span<const struct iovec> iov);
+
+// Copies everything from the current offset of |from_fd| to EOF into |to_fd|
+// at its current offset. The copy is done in the kernel where possible
+// (copy_file_range(), which can share extents on reflink-capable file systems,
+// and then sendfile()), falling back to a read()/write() loop. Returns true on
+// success.
+bool CopyFileContents(int from_fd, int to_fd);
+
 }  // namespace base
 
 #endif  // BUILDFLAG(IS_POSIX)
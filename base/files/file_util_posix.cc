@@ -4,12 +4,166 @@
 
 #include "base/files/file_util.h"
 
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include "base/files/file_path.h"
+#include "base/files/scoped_file.h"
 #include "base/posix/eintr_wrapper.h"
 
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) || BUILDFLAG(IS_ANDROID)
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
+#endif
+
 namespace base {
 
+namespace {
+
+// Initial buffer size for files whose size fstat() does not report.
+constexpr size_t kInitialUnsizedReadSize = 4096;
+
+// Buffer size for the read()/write() copy fallback.
+constexpr size_t kCopyBufferSize = 128 * 1024;
+
+// The largest request passed to a single in-kernel copy call. Linux caps
+// sendfile() and copy_file_range() at just under 2 GB regardless.
+constexpr size_t kMaxKernelCopyChunk = 1 << 30;
+
+// The number of iovecs handed to a single readv()/writev() call.
+#if defined(IOV_MAX)
+constexpr size_t kMaxIovecsPerCall = std::min<size_t>(IOV_MAX, 1024);
+#else
+constexpr size_t kMaxIovecsPerCall = 16;
+#endif
+
+// Reads from |fd| until EOF into a buffer that grows geometrically, starting
+// with the |initial_size| bytes already in |buffer|.
+bool ReadUnsizedFD(int fd,
+                   HeapArray<uint8_t> buffer,
+                   size_t initial_size,
+                   HeapArray<uint8_t>* contents) {
+  size_t size = initial_size;
+  if (buffer.size() < kInitialUnsizedReadSize) {
+    HeapArray<uint8_t> larger =
+        HeapArray<uint8_t>::Uninit(kInitialUnsizedReadSize);
+    larger.first(size).copy_from(buffer.first(size));
+    buffer = std::move(larger);
+  }
+  while (true) {
+    if (size == buffer.size()) {
+      HeapArray<uint8_t> larger = HeapArray<uint8_t>::Uninit(size * 2);
+      larger.first(size).copy_from(buffer.first(size));
+      buffer = std::move(larger);
+    }
+    ssize_t bytes_read =
+        HANDLE_EINTR(read(fd, buffer.data() + size, buffer.size() - size));
+    if (bytes_read < 0) {
+      return false;
+    }
+    if (bytes_read == 0) {
+      break;
+    }
+    size += static_cast<size_t>(bytes_read);
+  }
+  *contents = HeapArray<uint8_t>::CopiedFrom(buffer.first(size));
+  return true;
+}
+
+// Shared implementation of ReadvFromFD() and WritevToFD(). |transfer| is
+// readv or writev. At most kMaxIovecsPerCall iovecs are copied to the stack
+// per call so that the first one can be trimmed after a partial transfer
+// without modifying the caller's array.
+template <typename Transfer>
+bool TransferIovecs(int fd, span<const struct iovec> iov, Transfer transfer) {
+  struct iovec window[kMaxIovecsPerCall];
+  size_t next = 0;
+  size_t skip = 0;
+  while (true) {
+    while (next < iov.size() && iov[next].iov_len == skip) {
+      ++next;
+      skip = 0;
+    }
+    if (next == iov.size()) {
+      return true;
+    }
+
+    size_t count = std::min(iov.size() - next, kMaxIovecsPerCall);
+    for (size_t i = 0; i < count; ++i) {
+      window[i] = iov[next + i];
+    }
+    window[0].iov_base = static_cast<char*>(window[0].iov_base) + skip;
+    window[0].iov_len -= skip;
+
+    ssize_t result =
+        HANDLE_EINTR(transfer(fd, window, static_cast<int>(count)));
+    if (result <= 0) {
+      return false;
+    }
+
+    size_t done = static_cast<size_t>(result);
+    while (done > 0) {
+      size_t remaining = iov[next].iov_len - skip;
+      if (done < remaining) {
+        skip += done;
+        break;
+      }
+      done -= remaining;
+      ++next;
+      skip = 0;
+    }
+  }
+}
+
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) || BUILDFLAG(IS_ANDROID)
+
+enum class KernelCopyResult {
+  kDone,
+  kUnsupported,
+  kFailed,
+};
+
+// Errors from copy_file_range() and sendfile() that mean the call cannot be
+// used for this pair of descriptors, as opposed to an I/O error.
+bool IsUnsupportedCopyError(int error) {
+  return error == ENOSYS || error == EINVAL || error == EXDEV ||
+         error == EOPNOTSUPP || error == EPERM || error == EBADF;
+}
+
+// Runs |copy_chunk| until it reports EOF. If the very first call copies
+// nothing, the result is treated as unsupported: some kernels report 0 for
+// procfs and sysfs files whose size is not known in advance.
+template <typename CopyChunk>
+KernelCopyResult CopyInKernel(CopyChunk copy_chunk) {
+  bool copied_any = false;
+  while (true) {
+    ssize_t result = HANDLE_EINTR(copy_chunk(kMaxKernelCopyChunk));
+    if (result < 0) {
+      return !copied_any && IsUnsupportedCopyError(errno)
+                 ? KernelCopyResult::kUnsupported
+                 : KernelCopyResult::kFailed;
+    }
+    if (result == 0) {
+      return copied_any ? KernelCopyResult::kDone
+                        : KernelCopyResult::kUnsupported;
+    }
+    copied_any = true;
+  }
+}
+
+#endif  // BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) ||
+        // BUILDFLAG(IS_ANDROID)
+
+}  // namespace
+
 bool ReadFromFD(int fd, char* buffer, size_t bytes) {
   size_t total_read = 0;
   while (total_read < bytes) {
@@ -23,4 +177,132 @@ bool ReadFromFD(int fd, char* buffer, size_t bytes) {
   return total_read == bytes;
 }
 
+bool ReadFileToBuffer(const FilePath& path, HeapArray<uint8_t>* contents) {
+  ScopedFD fd(HANDLE_EINTR(open(path.value().c_str(), O_RDONLY | O_CLOEXEC)));
+  if (!fd.is_valid()) {
+    return false;
+  }
+
+  struct stat file_info;
+  if (fstat(fd.get(), &file_info) != 0) {
+    return false;
+  }
+  if (!S_ISREG(file_info.st_mode) || file_info.st_size <= 0) {
+    return ReadUnsizedFD(fd.get(), HeapArray<uint8_t>(), 0, contents);
+  }
+
+  size_t expected_size = static_cast<size_t>(file_info.st_size);
+  HeapArray<uint8_t> buffer = HeapArray<uint8_t>::Uninit(expected_size);
+  size_t size = 0;
+  while (size < expected_size) {
+    ssize_t bytes_read = HANDLE_EINTR(
+        read(fd.get(), buffer.data() + size, expected_size - size));
+    if (bytes_read < 0) {
+      return false;
+    }
+    if (bytes_read == 0) {
+      // The file shrank after fstat().
+      *contents = HeapArray<uint8_t>::CopiedFrom(buffer.first(size));
+      return true;
+    }
+    size += static_cast<size_t>(bytes_read);
+  }
+
+  // Probe for growth after fstat() with a one-byte read, so that the common
+  // case needs no second allocation.
+  uint8_t probe;
+  ssize_t probe_read = HANDLE_EINTR(read(fd.get(), &probe, 1));
+  if (probe_read < 0) {
+    return false;
+  }
+  if (probe_read == 0) {
+    *contents = std::move(buffer);
+    return true;
+  }
+  HeapArray<uint8_t> larger = HeapArray<uint8_t>::Uninit(size * 2);
+  larger.first(size).copy_from(buffer.as_span());
+  larger[size] = probe;
+  return ReadUnsizedFD(fd.get(), std::move(larger), size + 1, contents);
+}
+
+bool WriteFileDescriptor(int fd, span<const uint8_t> data) {
+  while (!data.empty()) {
+    ssize_t bytes_written = HANDLE_EINTR(write(fd, data.data(), data.size()));
+    if (bytes_written <= 0) {
+      return false;
+    }
+    data = data.subspan(static_cast<size_t>(bytes_written));
+  }
+  return true;
+}
+
+bool WriteFileAtomically(const FilePath& path, span<const uint8_t> data) {
+  std::string temp_path = path.value() + ".XXXXXX";
+  ScopedFD fd(HANDLE_EINTR(mkostemp(temp_path.data(), O_CLOEXEC)));
+  if (!fd.is_valid()) {
+    return false;
+  }
+
+  if (!WriteFileDescriptor(fd.get(), data) || HANDLE_EINTR(fsync(fd.get())) ||
+      IGNORE_EINTR(close(fd.release())) != 0 ||
+      rename(temp_path.c_str(), path.value().c_str()) != 0) {
+    unlink(temp_path.c_str());
+    return false;
+  }
+
+  // Make the rename durable. Not every file system supports fsync() on a
+  // directory, so failure here does not undo the (already visible) write.
+  ScopedFD dir_fd(HANDLE_EINTR(open(path.DirName().value().c_str(),
+                                    O_RDONLY | O_DIRECTORY | O_CLOEXEC)));
+  if (dir_fd.is_valid()) {
+    HANDLE_EINTR(fsync(dir_fd.get()));
+  }
+  return true;
+}
+
+bool ReadvFromFD(int fd, span<const struct iovec> iov) {
+  return TransferIovecs(fd, iov, readv);
+}
+
+bool WritevToFD(int fd, span<const struct iovec> iov) {
+  return TransferIovecs(fd, iov, writev);
+}
+
+bool CopyFileContents(int from_fd, int to_fd) {
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) || BUILDFLAG(IS_ANDROID)
+  KernelCopyResult result = KernelCopyResult::kUnsupported;
+#if defined(__NR_copy_file_range)
+  result = CopyInKernel([from_fd, to_fd](size_t length) {
+    return static_cast<ssize_t>(syscall(__NR_copy_file_range, from_fd, nullptr,
+                                        to_fd, nullptr, length, 0u));
+  });
+#endif  // defined(__NR_copy_file_range)
+  if (result == KernelCopyResult::kUnsupported) {
+    result = CopyInKernel([from_fd, to_fd](size_t length) {
+      return sendfile(to_fd, from_fd, nullptr, length);
+    });
+  }
+  if (result != KernelCopyResult::kUnsupported) {
+    return result == KernelCopyResult::kDone;
+  }
+#endif  // BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) ||
+        // BUILDFLAG(IS_ANDROID)
+
+  HeapArray<uint8_t> buffer = HeapArray<uint8_t>::Uninit(kCopyBufferSize);
+  while (true) {
+    ssize_t bytes_read =
+        HANDLE_EINTR(read(from_fd, buffer.data(), buffer.size()));
+    if (bytes_read < 0) {
+      return false;
+    }
+    if (bytes_read == 0) {
+      return true;
+    }
+    if (!WriteFileDescriptor(
+            to_fd, buffer.first(static_cast<size_t>(bytes_read)))) {
+      return false;
+    }
+  }
+}
+
 }  // namespace base
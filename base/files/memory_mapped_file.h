@@ -0,0 +1,138 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MINI_CHROMIUM_BASE_FILES_MEMORY_MAPPED_FILE_H_
+#define MINI_CHROMIUM_BASE_FILES_MEMORY_MAPPED_FILE_H_
+
+#include "build/build_config.h"
+
+#if BUILDFLAG(IS_POSIX)
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "base/containers/span.h"
+#include "base/files/scoped_file.h"
+
+namespace base {
+
+class FilePath;
+
+// Maps all or part of a file into memory, so that large read-mostly data
+// (lookup tables, models) is paged in on demand and shared with the page
+// cache instead of being copied onto the heap.
+//
+//   MemoryMappedFile file;
+//   if (!file.Initialize(path)) {
+//     return false;
+//   }
+//   Parse(file.bytes());
+//
+// Accessing the mapping after the underlying file has been truncated by
+// another process raises SIGBUS, as with any file mapping.
+class MemoryMappedFile {
+ public:
+  enum Access {
+    // Mapping a file into memory effectively allows for file I/O on any
+    // thread. The accessing thread could be paused while data from the file
+    // is paged into memory.
+    READ_ONLY,
+    // Changes made through mutable_bytes() are written back to the file.
+    READ_WRITE,
+  };
+
+  // Access pattern hints passed to madvise().
+  enum class AccessPattern {
+    kNormal,
+    // Pages are touched in increasing order, so the kernel reads ahead
+    // aggressively and drops pages behind the reader sooner.
+    kSequential,
+    // Pages are touched in no particular order, so readahead is disabled.
+    kRandom,
+  };
+
+  // The part of a file to map. |offset| need not be page aligned.
+  struct Region {
+    static const Region kWholeFile;
+
+    bool operator==(const Region& other) const = default;
+
+    int64_t offset;
+    size_t size;
+  };
+
+  struct Options {
+    Access access = READ_ONLY;
+    AccessPattern access_pattern = AccessPattern::kNormal;
+
+    // Fault the whole mapping in up front (MAP_POPULATE on Linux, a
+    // MADV_WILLNEED hint elsewhere), trading startup time for no page faults
+    // on first access.
+    bool prefetch = false;
+
+    // Place the mapping so that it can be backed by transparent huge pages,
+    // and ask for them with MADV_HUGEPAGE. This only takes effect on kernels
+    // and file systems that support huge pages for file mappings, and is
+    // otherwise harmless.
+    bool huge_page_aligned = false;
+  };
+
+  MemoryMappedFile();
+
+  MemoryMappedFile(const MemoryMappedFile&) = delete;
+  MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+  ~MemoryMappedFile();
+
+  // Opens and maps the whole of |file_name|. Returns false on failure. Must
+  // not be called on an already initialized object.
+  bool Initialize(const FilePath& file_name, Access access = READ_ONLY);
+
+  // Maps |region| of |file|, which must have been opened with permissions
+  // suitable for |access|. The descriptor is closed once the mapping exists.
+  // A region that extends past the end of the file is rejected.
+  bool Initialize(ScopedFD file,
+                  const Region& region,
+                  Access access = READ_ONLY);
+  bool Initialize(ScopedFD file,
+                  const Region& region,
+                  const Options& options);
+
+  // Changes the access pattern hint for the mapping. Returns false if the
+  // hint could not be applied.
+  bool SetAccessPattern(AccessPattern access_pattern);
+
+  const uint8_t* data() const { return data_; }
+  size_t length() const { return length_; }
+
+  span<const uint8_t> bytes() const { return make_span(data_, length_); }
+
+  // Only valid for READ_WRITE mappings.
+  span<uint8_t> mutable_bytes() const;
+
+  // Whether the file was successfully mapped. Zero-length files are valid but
+  // have no data.
+  bool IsValid() const { return valid_; }
+
+ private:
+  bool MapFileRegionToMemory(int fd, const Region& region,
+                             const Options& options);
+  void CloseHandles();
+
+  // The start and size of the page-aligned mapping, which contains
+  // [data_, data_ + length_).
+  void* mapping_ = nullptr;
+  size_t mapping_length_ = 0;
+
+  uint8_t* data_ = nullptr;
+  size_t length_ = 0;
+  Access access_ = READ_ONLY;
+  bool valid_ = false;
+};
+
+}  // namespace base
+
+#endif  // BUILDFLAG(IS_POSIX)
+
+#endif  // MINI_CHROMIUM_BASE_FILES_MEMORY_MAPPED_FILE_H_
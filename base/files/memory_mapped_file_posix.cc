@@ -0,0 +1,224 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/files/memory_mapped_file.h"
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <limits>
+#include <utility>
+
+#include "base/check.h"
+#include "base/files/file_path.h"
+#include "base/memory/page_size.h"
+#include "base/posix/eintr_wrapper.h"
+
+namespace base {
+
+namespace {
+
+// The PMD-level huge page size on x86-64 and on arm64 with 4 kB pages.
+constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+
+int AccessPatternToAdvice(MemoryMappedFile::AccessPattern access_pattern) {
+  switch (access_pattern) {
+    case MemoryMappedFile::AccessPattern::kNormal:
+      return MADV_NORMAL;
+    case MemoryMappedFile::AccessPattern::kSequential:
+      return MADV_SEQUENTIAL;
+    case MemoryMappedFile::AccessPattern::kRandom:
+      return MADV_RANDOM;
+  }
+  return MADV_NORMAL;
+}
+
+// Reserves |length| bytes of address space at an address congruent to
+// |file_offset| modulo kHugePageSize, so that huge-page-sized runs of the file
+// line up with huge-page-sized runs of memory. Returns nullptr on failure.
+void* ReserveHugePageAlignedRange(size_t length, size_t file_offset) {
+  // The mapping covers whole pages, and the tail to trim must start on one.
+  const size_t page_size = GetPageSize();
+  length = (length + page_size - 1) / page_size * page_size;
+  size_t reservation_length = length + kHugePageSize;
+  void* reservation = mmap(nullptr, reservation_length, PROT_NONE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (reservation == MAP_FAILED) {
+    return nullptr;
+  }
+  uintptr_t start = reinterpret_cast<uintptr_t>(reservation);
+  uintptr_t phase = file_offset % kHugePageSize;
+  uintptr_t aligned =
+      start + (phase + kHugePageSize - start % kHugePageSize) % kHugePageSize;
+  uintptr_t end = start + reservation_length;
+  if (aligned > start) {
+    PCHECK(munmap(reservation, aligned - start) == 0);
+  }
+  if (end > aligned + length) {
+    PCHECK(munmap(reinterpret_cast<void*>(aligned + length),
+                  end - (aligned + length)) == 0);
+  }
+  return reinterpret_cast<void*>(aligned);
+}
+
+}  // namespace
+
+const MemoryMappedFile::Region MemoryMappedFile::Region::kWholeFile = {0, 0};
+
+MemoryMappedFile::MemoryMappedFile() = default;
+
+MemoryMappedFile::~MemoryMappedFile() {
+  CloseHandles();
+}
+
+bool MemoryMappedFile::Initialize(const FilePath& file_name, Access access) {
+  int flags = (access == READ_WRITE ? O_RDWR : O_RDONLY) | O_CLOEXEC;
+  ScopedFD file(HANDLE_EINTR(open(file_name.value().c_str(), flags)));
+  if (!file.is_valid()) {
+    return false;
+  }
+  return Initialize(std::move(file), Region::kWholeFile, access);
+}
+
+bool MemoryMappedFile::Initialize(ScopedFD file,
+                                  const Region& region,
+                                  Access access) {
+  Options options;
+  options.access = access;
+  return Initialize(std::move(file), region, options);
+}
+
+bool MemoryMappedFile::Initialize(ScopedFD file,
+                                  const Region& region,
+                                  const Options& options) {
+  DCHECK(!IsValid());
+  if (!file.is_valid()) {
+    return false;
+  }
+  if (!MapFileRegionToMemory(file.get(), region, options)) {
+    CloseHandles();
+    return false;
+  }
+  access_ = options.access;
+  valid_ = true;
+  return true;
+}
+
+bool MemoryMappedFile::SetAccessPattern(AccessPattern access_pattern) {
+  if (!mapping_) {
+    return IsValid();
+  }
+  return madvise(mapping_, mapping_length_,
+                 AccessPatternToAdvice(access_pattern)) == 0;
+}
+
+span<uint8_t> MemoryMappedFile::mutable_bytes() const {
+  CHECK_EQ(access_, READ_WRITE);
+  return make_span(data_, length_);
+}
+
+bool MemoryMappedFile::MapFileRegionToMemory(int fd,
+                                             const Region& region,
+                                             const Options& options) {
+  struct stat file_info;
+  if (fstat(fd, &file_info) != 0 || file_info.st_size < 0) {
+    return false;
+  }
+  uint64_t file_size = static_cast<uint64_t>(file_info.st_size);
+
+  uint64_t offset;
+  uint64_t size;
+  if (region == Region::kWholeFile) {
+    offset = 0;
+    size = file_size;
+  } else {
+    if (region.offset < 0) {
+      return false;
+    }
+    offset = static_cast<uint64_t>(region.offset);
+    size = region.size;
+    // Touching pages beyond the end of the file would raise SIGBUS.
+    if (offset > file_size || size > file_size - offset) {
+      return false;
+    }
+  }
+  if (size > std::numeric_limits<size_t>::max() / 2 ||
+      offset > static_cast<uint64_t>(std::numeric_limits<off_t>::max())) {
+    return false;
+  }
+  if (size == 0) {
+    return true;
+  }
+
+  // mmap() needs a page-aligned file offset; map from the page containing
+  // |offset| and point |data_| into it.
+  const size_t page_size = GetPageSize();
+  uint64_t aligned_offset = offset - offset % page_size;
+  size_t data_offset = static_cast<size_t>(offset - aligned_offset);
+  size_t map_length = data_offset + static_cast<size_t>(size);
+
+  int prot = PROT_READ | (options.access == READ_WRITE ? PROT_WRITE : 0);
+  int flags = MAP_SHARED;
+#if defined(MAP_POPULATE)
+  if (options.prefetch) {
+    flags |= MAP_POPULATE;
+  }
+#endif  // defined(MAP_POPULATE)
+
+  void* address = nullptr;
+  if (options.huge_page_aligned) {
+    address = ReserveHugePageAlignedRange(
+        map_length, static_cast<size_t>(aligned_offset));
+    if (!address) {
+      return false;
+    }
+    flags |= MAP_FIXED;
+  }
+
+  void* mapping = mmap(address, map_length, prot, flags, fd,
+                       static_cast<off_t>(aligned_offset));
+  if (mapping == MAP_FAILED) {
+    if (address) {
+      munmap(address, map_length);
+    }
+    return false;
+  }
+  mapping_ = mapping;
+  mapping_length_ = map_length;
+  data_ = static_cast<uint8_t*>(mapping) + data_offset;
+  length_ = static_cast<size_t>(size);
+
+  // The remaining hints are advisory, so failures are ignored.
+#if defined(MADV_HUGEPAGE)
+  if (options.huge_page_aligned) {
+    madvise(mapping_, mapping_length_, MADV_HUGEPAGE);
+  }
+#endif  // defined(MADV_HUGEPAGE)
+  if (options.access_pattern != AccessPattern::kNormal) {
+    madvise(mapping_, mapping_length_,
+            AccessPatternToAdvice(options.access_pattern));
+  }
+#if !defined(MAP_POPULATE)
+  if (options.prefetch) {
+    madvise(mapping_, mapping_length_, MADV_WILLNEED);
+  }
+#endif  // !defined(MAP_POPULATE)
+  return true;
+}
+
+void MemoryMappedFile::CloseHandles() {
+  if (mapping_) {
+    munmap(mapping_, mapping_length_);
+  }
+  mapping_ = nullptr;
+  mapping_length_ = 0;
+  data_ = nullptr;
+  length_ = 0;
+  access_ = READ_ONLY;
+  valid_ = false;
+}
+
+}  // namespace base
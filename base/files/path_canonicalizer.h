@@ -0,0 +1,95 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MINI_CHROMIUM_BASE_FILES_PATH_CANONICALIZER_H_
+#define MINI_CHROMIUM_BASE_FILES_PATH_CANONICALIZER_H_
+
+#include "build/build_config.h"
+
+#if BUILDFLAG(IS_POSIX)
+
+#include <stddef.h>
+
+#include <functional>
+#include <string_view>
+#include <unordered_map>
+
+#include "base/files/file_path.h"
+
+namespace base {
+
+// Resolves many paths to their canonical absolute form, as realpath() does:
+// symbolic links are followed, and kCurrentDirectory and kParentDirectory
+// components and redundant separators are removed.
+//
+// realpath() examines every component of every path it is given. A
+// PathCanonicalizer instead remembers what it learned about each directory
+// prefix (whether it exists, is a directory, or is a link and to where), so
+// canonicalizing a batch of paths that share prefixes costs about one lstat()
+// per distinct prefix rather than one per component of each path:
+//
+//   PathCanonicalizer canonicalizer;
+//   for (const FilePath& path : paths) {
+//     FilePath canonical;
+//     if (canonicalizer.Canonicalize(path, &canonical)) {
+//       ...
+//     }
+//   }
+//
+// The cache reflects the file system as it was when each prefix was first
+// examined, and is never invalidated automatically; call ClearCache() after
+// changes that matter. A PathCanonicalizer is not thread-safe.
+class PathCanonicalizer {
+ public:
+  PathCanonicalizer();
+
+  PathCanonicalizer(const PathCanonicalizer&) = delete;
+  PathCanonicalizer& operator=(const PathCanonicalizer&) = delete;
+
+  ~PathCanonicalizer();
+
+  // Stores the canonical form of |path| in |canonical| and returns true, or
+  // returns false and sets errno (ENOENT, ENOTDIR, ELOOP, ...) if some
+  // component does not resolve. Relative paths are resolved against the
+  // working directory at the time of the first call.
+  bool Canonicalize(const FilePath& path, FilePath* canonical);
+
+  // Forgets everything learned about the file system.
+  void ClearCache();
+
+  // The number of prefixes currently cached.
+  size_t cache_size() const { return cache_.size(); }
+
+ private:
+  struct CachedPrefix {
+    int error = 0;
+    bool is_directory = false;
+    bool is_symbolic_link = false;
+    FilePath::StringType link_target;
+  };
+
+  struct StringViewHash {
+    using is_transparent = void;
+    size_t operator()(FilePath::StringViewType value) const {
+      return std::hash<FilePath::StringViewType>()(value);
+    }
+  };
+
+  // Returns what is known about |prefix|, examining the file system on the
+  // first request.
+  const CachedPrefix& LookUp(const FilePath::StringType& prefix);
+
+  FilePath::StringType working_directory_;
+  std::unordered_map<FilePath::StringType,
+                     CachedPrefix,
+                     StringViewHash,
+                     std::equal_to<>>
+      cache_;
+};
+
+}  // namespace base
+
+#endif  // BUILDFLAG(IS_POSIX)
+
+#endif  // MINI_CHROMIUM_BASE_FILES_PATH_CANONICALIZER_H_
@@ -0,0 +1,173 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/files/path_canonicalizer.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <utility>
+
+namespace base {
+
+namespace {
+
+// The limit on links followed while resolving one path, as in Linux's
+// path walk.
+constexpr int kMaxSymbolicLinks = 40;
+
+bool GetWorkingDirectory(FilePath::StringType* directory) {
+  FilePath::StringType buffer(PATH_MAX, '\0');
+  while (!getcwd(buffer.data(), buffer.size())) {
+    if (errno != ERANGE) {
+      return false;
+    }
+    buffer.resize(buffer.size() * 2);
+  }
+  buffer.resize(FilePath::StringType::traits_type::length(buffer.c_str()));
+  *directory = std::move(buffer);
+  return true;
+}
+
+}  // namespace
+
+PathCanonicalizer::PathCanonicalizer() = default;
+
+PathCanonicalizer::~PathCanonicalizer() = default;
+
+bool PathCanonicalizer::Canonicalize(const FilePath& path,
+                                     FilePath* canonical) {
+  if (path.empty()) {
+    errno = ENOENT;
+    return false;
+  }
+
+  // |unresolved| is consumed from |position| onwards, one component at a
+  // time, and grows when a link's target is spliced in.
+  FilePath::StringType unresolved;
+  if (path.IsAbsolute()) {
+    unresolved = path.value();
+  } else {
+    if (working_directory_.empty() &&
+        !GetWorkingDirectory(&working_directory_)) {
+      return false;
+    }
+    unresolved.reserve(working_directory_.length() + 1 + path.value().length());
+    unresolved.append(working_directory_);
+    unresolved.append(1, FilePath::kSeparators[0]);
+    unresolved.append(path.value());
+  }
+
+  // |resolved| is always canonical, so a kParentDirectory component can be
+  // applied to it lexically.
+  FilePath::StringType resolved(1, FilePath::kSeparators[0]);
+  int links_followed = 0;
+  size_t position = 0;
+  while (true) {
+    while (position < unresolved.length() &&
+           FilePath::IsSeparator(unresolved[position])) {
+      ++position;
+    }
+    if (position == unresolved.length()) {
+      break;
+    }
+    size_t end = position;
+    while (end < unresolved.length() &&
+           !FilePath::IsSeparator(unresolved[end])) {
+      ++end;
+    }
+    FilePath::StringViewType component(unresolved.data() + position,
+                                       end - position);
+    position = end;
+
+    if (component == FilePath::kCurrentDirectory) {
+      continue;
+    }
+    if (component == FilePath::kParentDirectory) {
+      size_t last_separator = resolved.find_last_of(FilePath::kSeparators);
+      resolved.resize(last_separator == 0 ? 1 : last_separator);
+      continue;
+    }
+
+    size_t parent_length = resolved.length();
+    if (parent_length > 1) {
+      resolved.append(1, FilePath::kSeparators[0]);
+    }
+    resolved.append(component);
+    const CachedPrefix& prefix = LookUp(resolved);
+    if (prefix.error) {
+      errno = prefix.error;
+      return false;
+    }
+
+    if (prefix.is_symbolic_link) {
+      if (++links_followed > kMaxSymbolicLinks) {
+        errno = ELOOP;
+        return false;
+      }
+      // The rest of |unresolved| begins with a separator, if it is not empty.
+      FilePath::StringType rest(prefix.link_target);
+      rest.append(unresolved, position);
+      unresolved = std::move(rest);
+      position = 0;
+      if (FilePath::IsSeparator(prefix.link_target[0])) {
+        resolved.resize(1);
+      } else {
+        resolved.resize(parent_length);
+      }
+      continue;
+    }
+
+    // Anything after a non-directory, even a trailing separator, fails.
+    if (!prefix.is_directory && position < unresolved.length()) {
+      errno = ENOTDIR;
+      return false;
+    }
+  }
+
+  *canonical = FilePath(resolved);
+  return true;
+}
+
+void PathCanonicalizer::ClearCache() {
+  cache_.clear();
+  working_directory_.clear();
+}
+
+const PathCanonicalizer::CachedPrefix& PathCanonicalizer::LookUp(
+    const FilePath::StringType& prefix) {
+  auto it = cache_.find(FilePath::StringViewType(prefix));
+  if (it != cache_.end()) {
+    return it->second;
+  }
+
+  CachedPrefix entry;
+  struct stat file_info;
+  if (lstat(prefix.c_str(), &file_info) != 0) {
+    entry.error = errno;
+  } else if (S_ISLNK(file_info.st_mode)) {
+    // st_size is the target's length, but is 0 for some special files.
+    FilePath::StringType target(
+        file_info.st_size > 0 ? file_info.st_size + 1 : PATH_MAX, '\0');
+    ssize_t length = readlink(prefix.c_str(), target.data(), target.size());
+    if (length < 0) {
+      entry.error = errno;
+    } else if (length == 0) {
+      entry.error = ENOENT;
+    } else if (static_cast<size_t>(length) == target.size()) {
+      entry.error = ENAMETOOLONG;
+    } else {
+      target.resize(static_cast<size_t>(length));
+      entry.is_symbolic_link = true;
+      entry.link_target = std::move(target);
+    }
+  } else {
+    entry.is_directory = S_ISDIR(file_info.st_mode);
+  }
+  return cache_.emplace(prefix, std::move(entry)).first->second;
+}
+
+}  // namespace base
@@ -0,0 +1,82 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/memory/arena.h"
+
+#include <stdlib.h>
+
+#include <algorithm>
+
+namespace base {
+
+// A chunk's header, followed by |size| bytes of memory to allocate from.
+struct alignas(std::max_align_t) Arena::Chunk {
+  uint8_t* data() { return reinterpret_cast<uint8_t*>(this + 1); }
+
+  Chunk* next;
+  size_t size;
+};
+
+Arena::Arena(size_t first_chunk_size) : next_chunk_size_(first_chunk_size) {
+  DCHECK_GT(first_chunk_size, 0u);
+}
+
+Arena::Arena(span<uint8_t> initial_buffer)
+    : initial_buffer_(initial_buffer),
+      next_chunk_size_(std::max(initial_buffer.size() * 2,
+                                kDefaultFirstChunkSize)) {
+  Reset();
+}
+
+Arena::~Arena() {
+  while (first_chunk_) {
+    free(std::exchange(first_chunk_, first_chunk_->next));
+  }
+}
+
+void Arena::Reset() {
+  current_chunk_ = nullptr;
+  cursor_ = initial_buffer_.data();
+  limit_ = initial_buffer_.data() + initial_buffer_.size();
+}
+
+void* Arena::AllocateSlow(size_t size, size_t alignment) {
+  // Chunk memory is aligned to max_align_t, so only larger alignments need
+  // padding.
+  size_t padding = alignment > alignof(std::max_align_t)
+                       ? alignment - alignof(std::max_align_t)
+                       : 0;
+  CHECK_LE(size, SIZE_MAX - sizeof(Chunk) - padding);
+  size_t needed = size + padding;
+
+  // Chunks after the current one are left over from before Reset(), and are
+  // used in order while they are big enough.
+  Chunk* next = current_chunk_ ? current_chunk_->next : first_chunk_;
+  Chunk* chunk;
+  if (next && next->size >= needed) {
+    chunk = next;
+  } else {
+    size_t chunk_size = std::max(next_chunk_size_, needed);
+    if (chunk_size == next_chunk_size_ && chunk_size < kMaxChunkSize) {
+      next_chunk_size_ = std::min(chunk_size * 2, kMaxChunkSize);
+    }
+    chunk = static_cast<Chunk*>(malloc(sizeof(Chunk) + chunk_size));
+    CHECK(chunk) << "Out of memory allocating " << chunk_size << " bytes";
+    chunk->next = next;
+    chunk->size = chunk_size;
+    if (current_chunk_) {
+      current_chunk_->next = chunk;
+    } else {
+      first_chunk_ = chunk;
+    }
+    bytes_reserved_ += chunk_size;
+  }
+
+  current_chunk_ = chunk;
+  cursor_ = chunk->data();
+  limit_ = chunk->data() + chunk->size;
+  return Allocate(size, alignment);
+}
+
+}  // namespace base
@@ -0,0 +1,197 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MINI_CHROMIUM_BASE_MEMORY_ARENA_H_
+#define MINI_CHROMIUM_BASE_MEMORY_ARENA_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <bit>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "base/check.h"
+#include "base/check_op.h"
+#include "base/compiler_specific.h"
+#include "base/containers/heap_array.h"
+#include "base/containers/span.h"
+
+namespace base {
+
+namespace internal {
+
+// A HeapArray deleter for memory that belongs to an Arena. The memory is
+// released with the arena, so deleting the array does nothing.
+struct ArenaDeleter {
+  void operator()(const void* ptr) const {}
+};
+
+}  // namespace internal
+
+// A HeapArray whose memory belongs to an Arena. It must not outlive the
+// arena, or be used after the arena is Reset(). Only Arena::NewArray() and
+// NewUninitArray() make non-empty ones: HeapArray's own factories allocate
+// from the heap, which the arena would never free, so they are deleted.
+template <typename T>
+class ArenaArray : public HeapArray<T, internal::ArenaDeleter> {
+ public:
+  ArenaArray() = default;
+
+  static ArenaArray WithSize(size_t size) = delete;
+  static ArenaArray Uninit(size_t size) = delete;
+  static ArenaArray CopiedFrom(span<const T> that) = delete;
+  static ArenaArray FromOwningPointer(T* ptr, size_t size) = delete;
+
+ private:
+  friend class Arena;
+
+  explicit ArenaArray(HeapArray<T, internal::ArenaDeleter> array)
+      : HeapArray<T, internal::ArenaDeleter>(std::move(array)) {}
+};
+
+// Arena is a monotonic ("bump pointer") allocator for many short-lived
+// allocations that all die together, such as those made while handling one
+// request. Allocating is a pointer increment in the common case, nothing is
+// freed individually, and everything is released at once when the arena is
+// destroyed or Reset().
+//
+// Memory comes from chunks that start at `first_chunk_size` bytes and double
+// up to kMaxChunkSize as the arena grows; larger requests get a chunk of their
+// own. Reset() keeps the chunks for the next round of allocations, so an arena
+// that is reused for similar work stops calling malloc() altogether. An
+// InlineArena also starts with a buffer of its own, so small workloads never
+// allocate at all.
+//
+// Arena never runs destructors, so only trivially destructible objects can be
+// created in it. It is not thread-safe.
+//
+//   base::InlineArena<1024> arena;
+//   Header* header = arena.New<Header>();
+//   base::ArenaArray<uint32_t> offsets = arena.NewArray<uint32_t>(count);
+//   ...
+//   arena.Reset();  // Everything above is now invalid.
+class Arena {
+ public:
+  static constexpr size_t kDefaultFirstChunkSize = 4096;
+  static constexpr size_t kMaxChunkSize = 1024 * 1024;
+
+  Arena() : Arena(kDefaultFirstChunkSize) {}
+  explicit Arena(size_t first_chunk_size);
+
+  // Allocates from `initial_buffer` before allocating any chunks. The arena
+  // does not own the buffer, which must outlive it.
+  explicit Arena(span<uint8_t> initial_buffer);
+
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  ~Arena();
+
+  // Returns uninitialized memory for `size` bytes, aligned to `alignment`,
+  // which must be a power of two. Never returns null, except possibly for a
+  // zero-byte request, and crashes if memory is exhausted.
+  void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+    DCHECK(std::has_single_bit(alignment));
+    uintptr_t cursor = reinterpret_cast<uintptr_t>(cursor_);
+    uintptr_t aligned = (cursor + alignment - 1) & ~(alignment - 1);
+    uintptr_t limit = reinterpret_cast<uintptr_t>(limit_);
+    if (aligned >= cursor && aligned <= limit && size <= limit - aligned)
+        [[likely]] {
+      // SAFETY: `aligned` and `aligned + size` lie within the current chunk,
+      // checked above.
+      cursor_ = UNSAFE_BUFFERS(cursor_ + (aligned - cursor) + size);
+      return UNSAFE_BUFFERS(cursor_ - size);
+    }
+    return AllocateSlow(size, alignment);
+  }
+
+  // Constructs a T in the arena.
+  template <typename T, typename... Args>
+  T* New(Args&&... args) {
+    static_assert(std::is_trivially_destructible_v<T>,
+                  "Arena does not run destructors");
+    return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+  }
+
+  // Returns an array of `count` value-initialized (i.e. zeroed for primitive
+  // types) elements in the arena.
+  template <typename T>
+  ArenaArray<T> NewArray(size_t count) {
+    static_assert(std::is_trivially_destructible_v<T>,
+                  "Arena does not run destructors");
+    T* data = AllocateArray<T>(count);
+    std::uninitialized_value_construct_n(data, count);
+    // SAFETY: `data` points to `count` elements of T, which the no-op
+    // ArenaDeleter never frees.
+    return ArenaArray<T>(UNSAFE_BUFFERS(
+        HeapArray<T, internal::ArenaDeleter>::FromOwningPointer(data, count)));
+  }
+
+  // Returns an array of `count` uninitialized elements in the arena.
+  template <typename T>
+    requires(std::is_trivially_constructible_v<T> &&
+             std::is_trivially_destructible_v<T>)
+  ArenaArray<T> NewUninitArray(size_t count) {
+    T* data = AllocateArray<T>(count);
+    // SAFETY: `data` points to memory for `count` elements of T, which the
+    // no-op ArenaDeleter never frees.
+    return ArenaArray<T>(UNSAFE_BUFFERS(
+        HeapArray<T, internal::ArenaDeleter>::FromOwningPointer(data, count)));
+  }
+
+  // Makes all of the arena's memory available for reuse, without freeing it.
+  // Everything allocated from the arena so far becomes invalid.
+  void Reset();
+
+  // Returns the total size of the chunks that the arena has allocated, not
+  // counting the initial buffer.
+  size_t bytes_reserved() const { return bytes_reserved_; }
+
+ private:
+  struct Chunk;
+
+  // Returns memory for `count` elements of T, or null if `count` is zero.
+  template <typename T>
+  T* AllocateArray(size_t count) {
+    if (!count) {
+      return nullptr;
+    }
+    CHECK_LE(count, SIZE_MAX / sizeof(T));
+    return static_cast<T*>(Allocate(count * sizeof(T), alignof(T)));
+  }
+
+  NOINLINE void* AllocateSlow(size_t size, size_t alignment);
+
+  uint8_t* cursor_ = nullptr;
+  uint8_t* limit_ = nullptr;
+
+  const span<uint8_t> initial_buffer_;
+
+  // Chunks, in the order in which they are used. |current_chunk_| is null
+  // while allocating from |initial_buffer_|.
+  Chunk* first_chunk_ = nullptr;
+  Chunk* current_chunk_ = nullptr;
+
+  size_t next_chunk_size_;
+  size_t bytes_reserved_ = 0;
+};
+
+// An Arena that allocates from a buffer of `kInlineSize` bytes inside itself
+// before allocating any chunks. Declared on the stack, it handles small
+// workloads without touching the heap.
+template <size_t kInlineSize>
+class InlineArena : public Arena {
+ public:
+  InlineArena() : Arena(span<uint8_t>(buffer_)) {}
+
+ private:
+  alignas(std::max_align_t) uint8_t buffer_[kInlineSize];
+};
+
+}  // namespace base
+
+#endif  // MINI_CHROMIUM_BASE_MEMORY_ARENA_H_
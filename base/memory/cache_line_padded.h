@@ -0,0 +1,60 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MINI_CHROMIUM_BASE_MEMORY_CACHE_LINE_PADDED_H_
+#define MINI_CHROMIUM_BASE_MEMORY_CACHE_LINE_PADDED_H_
+
+#include <stddef.h>
+
+#include <utility>
+
+#include "build/build_config.h"
+
+namespace base {
+
+// The granularity at which independently-written data should be separated to
+// avoid false sharing. Apple arm64 cores have 128-byte lines, and x86 cores
+// prefetch adjacent 64-byte lines in pairs, so 128 is used on both. This is
+// deliberately not std::hardware_destructive_interference_size, whose value
+// is not ABI-stable across compiler versions and flags.
+#if defined(ARCH_CPU_X86_FAMILY) || defined(ARCH_CPU_ARM64)
+inline constexpr size_t kCacheLineSize = 128;
+#else
+inline constexpr size_t kCacheLineSize = 64;
+#endif
+
+// Holds a T on a cache line (or pair of lines) of its own, so that writes to
+// it do not invalidate neighbouring data held by other cores. Use for
+// frequently-written shared state such as counters and flags:
+//
+//   base::CacheLinePadded<base::AtomicCounter<int64_t>> g_requests;
+//   g_requests->Increment();
+//
+// Arrays of CacheLinePadded<T> place each element on its own line.
+template <typename T>
+class alignas(kCacheLineSize) CacheLinePadded {
+ public:
+  template <typename... Args>
+  constexpr explicit CacheLinePadded(Args&&... args)
+      : value_(std::forward<Args>(args)...) {}
+
+  CacheLinePadded(const CacheLinePadded&) = delete;
+  CacheLinePadded& operator=(const CacheLinePadded&) = delete;
+
+  T& get() { return value_; }
+  const T& get() const { return value_; }
+
+  T* operator->() { return &value_; }
+  const T* operator->() const { return &value_; }
+
+  T& operator*() { return value_; }
+  const T& operator*() const { return value_; }
+
+ private:
+  T value_;
+};
+
+}  // namespace base
+
+#endif  // MINI_CHROMIUM_BASE_MEMORY_CACHE_LINE_PADDED_H_
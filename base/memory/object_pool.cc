@@ -0,0 +1,239 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/memory/object_pool.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <cstddef>
+
+#include "base/process/memory.h"
+
+namespace base::internal {
+
+namespace {
+
+void* NextFreeSlot(void* slot) {
+  void* next;
+  memcpy(&next, slot, sizeof(next));
+  return next;
+}
+
+void SetNextFreeSlot(void* slot, void* next) {
+  memcpy(slot, &next, sizeof(next));
+}
+
+}  // namespace
+
+// A slab's header, followed by its slots.
+struct alignas(std::max_align_t) ObjectPoolBase::Slab {
+  uint8_t* data() { return reinterpret_cast<uint8_t*>(this + 1); }
+
+  Slab* next;
+};
+
+// Free slots are linked through their first word, so slots are at least the
+// size and alignment of a pointer.
+ObjectPoolBase::ObjectPoolBase(size_t size, size_t alignment)
+    : slot_size_((std::max(size, sizeof(void*)) +
+                  std::max(alignment, alignof(void*)) - 1) &
+                 ~(std::max(alignment, alignof(void*)) - 1)),
+      slots_per_slab_(std::max(kSlabSize / slot_size_, kMagazineSize)),
+      slot_(&OnThreadExit) {}
+
+ObjectPoolBase::~ObjectPoolBase() {
+  if (ThreadCache* cache = static_cast<ThreadCache*>(slot_.Get())) {
+    delete cache->loaded;
+    delete cache->previous;
+    delete cache;
+    slot_.Set(nullptr);
+  }
+  for (std::atomic<Magazine*>& entry : full_magazines_) {
+    delete entry.exchange(nullptr, std::memory_order_acquire);
+  }
+  for (std::atomic<Magazine*>& entry : empty_magazines_) {
+    delete entry.exchange(nullptr, std::memory_order_acquire);
+  }
+  while (slabs_) {
+    free(std::exchange(slabs_, slabs_->next));
+  }
+}
+
+void* ObjectPoolBase::AllocateSlow(ThreadCache* cache) {
+  cache = GetOrCreateThreadCache(cache);
+  if (!cache) {
+    // Without a cache, go straight to the central free list.
+    Magazine magazine;
+    if (!RefillFromCentral(&magazine)) {
+      return nullptr;
+    }
+    void* slot = magazine.slots[--magazine.count];
+    FlushToCentral(&magazine);
+    return slot;
+  }
+
+  Magazine*& loaded = cache->loaded;
+  Magazine*& previous = cache->previous;
+  if (loaded->count == 0) {
+    if (previous->count > 0) {
+      std::swap(loaded, previous);
+    } else if (Magazine* full = TakeFromDepot(full_magazines_)) {
+      // Both magazines are empty, so one of them can go back to the depot.
+      ReleaseEmptyMagazine(std::exchange(previous, loaded));
+      loaded = full;
+    } else if (!RefillFromCentral(loaded)) {
+      return nullptr;
+    }
+  }
+  return loaded->slots[--loaded->count];
+}
+
+void ObjectPoolBase::FreeSlow(ThreadCache* cache, void* slot) {
+  cache = GetOrCreateThreadCache(cache);
+  if (!cache) {
+    AutoLock lock(lock_);
+    SetNextFreeSlot(slot, free_list_);
+    free_list_ = slot;
+    return;
+  }
+
+  Magazine*& loaded = cache->loaded;
+  Magazine*& previous = cache->previous;
+  if (loaded->count == kMagazineSize) {
+    if (previous->count == kMagazineSize) {
+      // Both magazines are full, so one of them goes to the depot in exchange
+      // for an empty one. If that is not possible, its slots go to the
+      // central free list instead.
+      Magazine* empty = TakeEmptyMagazine();
+      if (empty && DepositInDepot(full_magazines_, previous)) {
+        previous = empty;
+      } else {
+        if (empty) {
+          ReleaseEmptyMagazine(empty);
+        }
+        FlushToCentral(previous);
+      }
+    }
+    std::swap(loaded, previous);
+  }
+  loaded->slots[loaded->count++] = slot;
+}
+
+ObjectPoolBase::ThreadCache* ObjectPoolBase::GetOrCreateThreadCache(
+    ThreadCache* cache) {
+  if (cache) {
+    return cache;
+  }
+  cache = new (std::nothrow) ThreadCache{this, nullptr, nullptr};
+  if (!cache) {
+    return nullptr;
+  }
+  cache->loaded = TakeEmptyMagazine();
+  cache->previous = TakeEmptyMagazine();
+  if (!cache->loaded || !cache->previous) {
+    delete cache->loaded;
+    delete cache->previous;
+    delete cache;
+    return nullptr;
+  }
+  slot_.Set(cache);
+  return cache;
+}
+
+// static
+ObjectPoolBase::Magazine* ObjectPoolBase::TakeFromDepot(
+    std::atomic<Magazine*> (&depot)[kDepotSize]) {
+  for (std::atomic<Magazine*>& entry : depot) {
+    if (entry.load(std::memory_order_relaxed)) {
+      if (Magazine* magazine =
+              entry.exchange(nullptr, std::memory_order_acquire)) {
+        return magazine;
+      }
+    }
+  }
+  return nullptr;
+}
+
+// static
+bool ObjectPoolBase::DepositInDepot(
+    std::atomic<Magazine*> (&depot)[kDepotSize],
+    Magazine* magazine) {
+  for (std::atomic<Magazine*>& entry : depot) {
+    Magazine* expected = nullptr;
+    if (!entry.load(std::memory_order_relaxed) &&
+        entry.compare_exchange_strong(expected, magazine,
+                                      std::memory_order_release,
+                                      std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+ObjectPoolBase::Magazine* ObjectPoolBase::TakeEmptyMagazine() {
+  if (Magazine* magazine = TakeFromDepot(empty_magazines_)) {
+    return magazine;
+  }
+  return new (std::nothrow) Magazine;
+}
+
+void ObjectPoolBase::ReleaseEmptyMagazine(Magazine* magazine) {
+  if (!DepositInDepot(empty_magazines_, magazine)) {
+    delete magazine;
+  }
+}
+
+bool ObjectPoolBase::RefillFromCentral(Magazine* magazine) {
+  AutoLock lock(lock_);
+  while (magazine->count < kMagazineSize && free_list_) {
+    magazine->slots[magazine->count++] =
+        std::exchange(free_list_, NextFreeSlot(free_list_));
+  }
+  if (magazine->count < kMagazineSize && slab_cursor_ == slab_limit_) {
+    size_t slab_bytes = slot_size_ * slots_per_slab_;
+    void* memory;
+    if (!UncheckedMalloc(sizeof(Slab) + slab_bytes, &memory)) {
+      return magazine->count > 0;
+    }
+    Slab* slab = static_cast<Slab*>(memory);
+    slab->next = slabs_;
+    slabs_ = slab;
+    slab_cursor_ = slab->data();
+    slab_limit_ = slab->data() + slab_bytes;
+    bytes_reserved_.fetch_add(slab_bytes, std::memory_order_relaxed);
+  }
+  while (magazine->count < kMagazineSize && slab_cursor_ != slab_limit_) {
+    magazine->slots[magazine->count++] = slab_cursor_;
+    slab_cursor_ += slot_size_;
+  }
+  return true;
+}
+
+void ObjectPoolBase::FlushToCentral(Magazine* magazine) {
+  AutoLock lock(lock_);
+  while (magazine->count > 0) {
+    void* slot = magazine->slots[--magazine->count];
+    SetNextFreeSlot(slot, free_list_);
+    free_list_ = slot;
+  }
+}
+
+// static
+void ObjectPoolBase::OnThreadExit(void* value) {
+  ThreadCache* cache = static_cast<ThreadCache*>(value);
+  ObjectPoolBase* pool = cache->pool;
+  for (Magazine* magazine : {cache->loaded, cache->previous}) {
+    if (magazine->count == kMagazineSize &&
+        DepositInDepot(pool->full_magazines_, magazine)) {
+      continue;
+    }
+    pool->FlushToCentral(magazine);
+    pool->ReleaseEmptyMagazine(magazine);
+  }
+  delete cache;
+}
+
+}  // namespace base::internal
@@ -0,0 +1,236 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MINI_CHROMIUM_BASE_MEMORY_OBJECT_POOL_H_
+#define MINI_CHROMIUM_BASE_MEMORY_OBJECT_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+#include "base/check.h"
+#include "base/compiler_specific.h"
+#include "base/synchronization/lock.h"
+#include "base/threading/thread_local_storage.h"
+
+namespace base {
+
+namespace internal {
+
+// The untyped implementation of ObjectPool<T>, which hands out slots of a
+// fixed size and alignment.
+class ObjectPoolBase {
+ public:
+  // The number of free slots a magazine holds.
+  static constexpr size_t kMagazineSize = 32;
+
+  // The number of full magazines the depot holds.
+  static constexpr size_t kDepotSize = 64;
+
+  // The size of the slabs that slots are carved from.
+  static constexpr size_t kSlabSize = 64 * 1024;
+
+  ObjectPoolBase(size_t size, size_t alignment);
+
+  ObjectPoolBase(const ObjectPoolBase&) = delete;
+  ObjectPoolBase& operator=(const ObjectPoolBase&) = delete;
+
+  ~ObjectPoolBase();
+
+  // Returns a free slot, or null if memory is exhausted.
+  void* Allocate() {
+    ThreadCache* cache = static_cast<ThreadCache*>(slot_.Get());
+    if (cache && cache->loaded->count > 0) [[likely]] {
+      return cache->loaded->slots[--cache->loaded->count];
+    }
+    return AllocateSlow(cache);
+  }
+
+  // Makes `slot`, which came from Allocate(), free for reuse.
+  void Free(void* slot) {
+    ThreadCache* cache = static_cast<ThreadCache*>(slot_.Get());
+    if (cache && cache->loaded->count < kMagazineSize) [[likely]] {
+      cache->loaded->slots[cache->loaded->count++] = slot;
+      return;
+    }
+    FreeSlow(cache, slot);
+  }
+
+  size_t bytes_reserved() const {
+    return bytes_reserved_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct Magazine {
+    size_t count = 0;
+    void* slots[kMagazineSize];
+  };
+
+  // A thread's cache. Slots are taken from and returned to |loaded|.
+  // |previous| is the magazine that was loaded before it, which is kept so
+  // that a thread alternating between allocating and freeing around a
+  // magazine boundary does not go to the depot every time.
+  struct ThreadCache {
+    ObjectPoolBase* pool;
+    Magazine* loaded;
+    Magazine* previous;
+  };
+
+  struct Slab;
+
+  NOINLINE void* AllocateSlow(ThreadCache* cache);
+  NOINLINE void FreeSlow(ThreadCache* cache, void* slot);
+
+  // Returns this thread's cache, creating it if needed. Returns null if
+  // memory is exhausted.
+  ThreadCache* GetOrCreateThreadCache(ThreadCache* cache);
+
+  // The depot is a pair of fixed arrays of entries, each either null or
+  // owning one magazine: one for full magazines and one for empty ones.
+  // Magazines are claimed with exchange() and deposited with
+  // compare_exchange() into an empty entry, so there is no ABA hazard.
+  static Magazine* TakeFromDepot(std::atomic<Magazine*> (&depot)[kDepotSize]);
+  static bool DepositInDepot(std::atomic<Magazine*> (&depot)[kDepotSize],
+                             Magazine* magazine);
+
+  // Returns an empty magazine from the depot, or a new one. Returns null if
+  // memory is exhausted.
+  Magazine* TakeEmptyMagazine();
+
+  // Keeps the empty `magazine` in the depot, or deletes it.
+  void ReleaseEmptyMagazine(Magazine* magazine);
+
+  // Fills the empty `magazine` from the central free list and fresh slab
+  // memory. Returns false if not a single slot is available.
+  bool RefillFromCentral(Magazine* magazine);
+
+  // Moves all of `magazine`'s slots to the central free list.
+  void FlushToCentral(Magazine* magazine);
+
+  // Hands a thread's magazines back to the pool when the thread exits.
+  static void OnThreadExit(void* value);
+
+  const size_t slot_size_;
+  const size_t slots_per_slab_;
+
+  ThreadLocalStorage::Slot slot_;
+
+  std::atomic<Magazine*> full_magazines_[kDepotSize] = {};
+  std::atomic<Magazine*> empty_magazines_[kDepotSize] = {};
+
+  // Guards the members below it.
+  Lock lock_;
+
+  // Free slots that are not in any magazine, linked through their first
+  // word.
+  void* free_list_ = nullptr;
+
+  // All slabs, and the unused part of the newest one.
+  Slab* slabs_ = nullptr;
+  uint8_t* slab_cursor_ = nullptr;
+  uint8_t* slab_limit_ = nullptr;
+
+  std::atomic<size_t> bytes_reserved_{0};
+};
+
+}  // namespace internal
+
+// ObjectPool<T> allocates T objects from slabs of fixed-size slots, for code
+// that creates and destroys many objects of one type, such as the nodes of a
+// container or per-request state. Freed slots are kept for reuse by later
+// objects.
+//
+// Each thread keeps a cache of free slots in a pair of "magazines" (arrays of
+// up to kMagazineSize slots), so that New() and Delete() take and return a
+// slot without synchronization in the common case. When a thread's magazines
+// are exhausted it swaps them for full ones from a lock-free depot shared by
+// all threads, and when they are full it hands one to the depot. Only when
+// the depot runs dry or overflows does the pool take a lock, to move slots to
+// or from a central free list or carve new slots from a fresh slab. A thread's
+// magazines are handed back to the pool when the thread exits.
+//
+// Objects may be deleted on any thread. Slabs are only freed when the pool is
+// destroyed, so the pool's memory use stays at its peak; in exchange, a freed
+// slot can hold any later object, so the pool does not fragment.
+//
+// New() crashes if memory is exhausted. UncheckedNew() reports failure like
+// UncheckedMalloc() does instead:
+//
+//   ObjectPool<TimerEntry>& TimerEntryPool() {
+//     static auto* pool = new ObjectPool<TimerEntry>();
+//     return *pool;
+//   }
+//
+//   TimerEntry* entry;
+//   if (!TimerEntryPool().UncheckedNew(&entry, deadline, std::move(task))) {
+//     return false;
+//   }
+//   ...
+//   TimerEntryPool().Delete(entry);
+//
+// A pool must outlive every thread that uses it, so it should usually be a
+// leaked function-local static, as above. Destroying a pool frees its slabs,
+// and with them any objects not yet deleted, without running their
+// destructors.
+template <typename T>
+class ObjectPool {
+ public:
+  static_assert(alignof(T) <= alignof(std::max_align_t),
+                "ObjectPool does not support over-aligned types");
+
+  static constexpr size_t kMagazineSize =
+      internal::ObjectPoolBase::kMagazineSize;
+
+  ObjectPool() : base_(sizeof(T), alignof(T)) {}
+
+  ObjectPool(const ObjectPool&) = delete;
+  ObjectPool& operator=(const ObjectPool&) = delete;
+
+  ~ObjectPool() = default;
+
+  // Constructs a T in the pool. Crashes if memory is exhausted.
+  template <typename... Args>
+  T* New(Args&&... args) {
+    void* slot = base_.Allocate();
+    CHECK(slot) << "Out of memory allocating a " << sizeof(T)
+                << "-byte object";
+    return new (slot) T(std::forward<Args>(args)...);
+  }
+
+  // Constructs a T in the pool and sets `*result` to it. Returns false, and
+  // leaves `*result` unchanged, if memory is exhausted.
+  template <typename... Args>
+  [[nodiscard]] bool UncheckedNew(T** result, Args&&... args) {
+    void* slot = base_.Allocate();
+    if (!slot) {
+      return false;
+    }
+    *result = new (slot) T(std::forward<Args>(args)...);
+    return true;
+  }
+
+  // Destroys `object`, which must have come from this pool, and frees its
+  // slot. Does nothing if `object` is null.
+  void Delete(T* object) {
+    if (!object) {
+      return;
+    }
+    object->~T();
+    base_.Free(object);
+  }
+
+  // Returns the total size of the slabs that the pool has allocated.
+  size_t bytes_reserved() const { return base_.bytes_reserved(); }
+
+ private:
+  internal::ObjectPoolBase base_;
+};
+
+}  // namespace base
+
+#endif  // MINI_CHROMIUM_BASE_MEMORY_OBJECT_POOL_H_
@@ -0,0 +1,90 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/metrics/sharded_counter.h"
+
+#include <algorithm>
+#include <bit>
+
+#include "base/atomic_counter.h"
+#include "build/build_config.h"
+
+#if BUILDFLAG(IS_WIN)
+#include <windows.h>
+#elif BUILDFLAG(IS_POSIX) || BUILDFLAG(IS_FUCHSIA)
+#include <unistd.h>
+#endif
+
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) || BUILDFLAG(IS_ANDROID)
+#include <sched.h>
+#endif
+
+namespace base {
+
+namespace {
+
+// Bounds the memory used by one counter: 256 slots of kCacheLineSize bytes.
+constexpr size_t kMaxShards = 256;
+
+size_t NumberOfProcessors() {
+#if BUILDFLAG(IS_WIN)
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  long count = info.dwNumberOfProcessors;
+#else
+  long count = sysconf(_SC_NPROCESSORS_CONF);
+#endif
+  return count > 0 ? static_cast<size_t>(count) : 1;
+}
+
+size_t ShardCount() {
+  static const size_t count =
+      std::bit_ceil(std::min(NumberOfProcessors(), kMaxShards));
+  return count;
+}
+
+uint32_t ThreadShardHint() {
+  static AtomicCounter<uint32_t> next_thread_index;
+  thread_local const uint32_t thread_index = next_thread_index.FetchAdd(1);
+  return thread_index;
+}
+
+}  // namespace
+
+namespace internal {
+
+uint32_t GetCounterShardHint() {
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) || BUILDFLAG(IS_ANDROID)
+  int cpu = sched_getcpu();
+  if (cpu >= 0) {
+    return static_cast<uint32_t>(cpu);
+  }
+#endif
+  return ThreadShardHint();
+}
+
+}  // namespace internal
+
+ShardedCounter::ShardedCounter()
+    : shard_mask_(ShardCount() - 1), slots_(new Slot[ShardCount()]) {}
+
+ShardedCounter::~ShardedCounter() = default;
+
+int64_t ShardedCounter::Sum() const {
+  int64_t sum = 0;
+  for (size_t i = 0; i <= shard_mask_; ++i) {
+    sum += slots_[i]->load(std::memory_order_relaxed);
+  }
+  return sum;
+}
+
+int64_t ShardedCounter::SumAndReset() {
+  int64_t sum = 0;
+  for (size_t i = 0; i <= shard_mask_; ++i) {
+    sum += slots_[i]->exchange(0, std::memory_order_relaxed);
+  }
+  return sum;
+}
+
+}  // namespace base
@@ -0,0 +1,73 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MINI_CHROMIUM_BASE_METRICS_SHARDED_COUNTER_H_
+#define MINI_CHROMIUM_BASE_METRICS_SHARDED_COUNTER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+
+#include "base/memory/cache_line_padded.h"
+
+namespace base {
+
+namespace internal {
+
+// Returns a small integer that tends to be the same for all increments made
+// on one CPU. On Linux and Android this is the current CPU number as reported
+// by the vDSO; elsewhere it is a per-thread index. The value is only a hint:
+// the thread may migrate immediately after reading it.
+uint32_t GetCounterShardHint();
+
+}  // namespace internal
+
+// A statistics counter for values that are incremented from many threads at
+// high frequency and read rarely. A single std::atomic<int64_t> incremented by
+// every core bounces its cache line between them; ShardedCounter instead
+// spreads increments over one cache-line-padded slot per CPU, so that an
+// increment is an uncontended relaxed add and reads pay the cost of visiting
+// every slot.
+//
+// Increments are not ordered with respect to one another or to other memory,
+// and Sum() is not an atomic snapshot: increments that race with it may or may
+// not be counted. Use a plain atomic if either property is needed.
+class ShardedCounter {
+ public:
+  ShardedCounter();
+
+  ShardedCounter(const ShardedCounter&) = delete;
+  ShardedCounter& operator=(const ShardedCounter&) = delete;
+
+  ~ShardedCounter();
+
+  // Adds |delta|, which may be negative, to the counter.
+  void Increment(int64_t delta = 1) {
+    slots_[internal::GetCounterShardHint() & shard_mask_]->fetch_add(
+        delta, std::memory_order_relaxed);
+  }
+
+  // Returns the current total. This reads every slot and does not modify the
+  // counter, so it is cheap enough to call periodically for export.
+  int64_t Sum() const;
+
+  // Returns the total accumulated since the last call to SumAndReset() (or
+  // since construction), and resets the counter. Increments that race with
+  // this call are counted exactly once, either here or by a later call.
+  int64_t SumAndReset();
+
+  size_t shard_count() const { return shard_mask_ + 1; }
+
+ private:
+  using Slot = CacheLinePadded<std::atomic<int64_t>>;
+
+  const size_t shard_mask_;
+  const std::unique_ptr<Slot[]> slots_;
+};
+
+}  // namespace base
+
+#endif  // MINI_CHROMIUM_BASE_METRICS_SHARDED_COUNTER_H_
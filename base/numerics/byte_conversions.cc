@@ -0,0 +1,179 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/numerics/byte_conversions.h"
+
+#include "base/check_op.h"
+#include "build/build_config.h"
+
+#if defined(ARCH_CPU_X86_FAMILY) && defined(COMPILER_GCC)
+#include <immintrin.h>
+#elif defined(ARCH_CPU_ARM64)
+#include <arm_neon.h>
+#endif
+
+namespace base::numerics::internal {
+
+namespace {
+
+template <class T>
+void SwapBytesScalar(const uint8_t* in, uint8_t* out, size_t size) {
+  for (size_t offset = 0; offset < size; offset += sizeof(T)) {
+    T value;
+    memcpy(&value, in + offset, sizeof(T));
+    value = SwapBytes(value);
+    memcpy(out + offset, &value, sizeof(value));
+  }
+}
+
+#if defined(ARCH_CPU_X86_FAMILY) && defined(COMPILER_GCC)
+
+// pshufb masks that reverse each 2-, 4- or 8-byte lane of a 16-byte vector.
+// AVX2's vpshufb shuffles each 16-byte half separately, so it uses the same
+// mask in both halves.
+alignas(16) constexpr uint8_t kSwapMask16[16] = {1, 0, 3,  2,  5,  4,  7,  6,
+                                                 9, 8, 11, 10, 13, 12, 15, 14};
+alignas(16) constexpr uint8_t kSwapMask32[16] = {3,  2,  1,  0,  7,  6,
+                                                 5,  4,  11, 10, 9,  8,
+                                                 15, 14, 13, 12};
+alignas(16) constexpr uint8_t kSwapMask64[16] = {7,  6,  5,  4,  3,  2,
+                                                 1,  0,  15, 14, 13, 12,
+                                                 11, 10, 9,  8};
+
+const uint8_t* SwapMask(size_t width) {
+  switch (width) {
+    case 2:
+      return kSwapMask16;
+    case 4:
+      return kSwapMask32;
+    default:
+      return kSwapMask64;
+  }
+}
+
+// Each vector kernel converts a whole number of vectors and returns the number
+// of bytes it converted, leaving the rest to SwapBytesScalar().
+
+__attribute__((target("ssse3"))) size_t SwapBytesSSSE3(const uint8_t* in,
+                                                      uint8_t* out,
+                                                      size_t size,
+                                                      size_t width) {
+  const __m128i mask =
+      _mm_load_si128(reinterpret_cast<const __m128i*>(SwapMask(width)));
+  size_t offset = 0;
+  for (; offset + 16 <= size; offset += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + offset));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + offset),
+                     _mm_shuffle_epi8(v, mask));
+  }
+  return offset;
+}
+
+__attribute__((target("avx2"))) size_t SwapBytesAVX2(const uint8_t* in,
+                                                    uint8_t* out,
+                                                    size_t size,
+                                                    size_t width) {
+  const __m256i mask = _mm256_broadcastsi128_si256(
+      _mm_load_si128(reinterpret_cast<const __m128i*>(SwapMask(width))));
+  size_t offset = 0;
+  // Two vectors per iteration keep both shuffle ports busy.
+  for (; offset + 64 <= size; offset += 64) {
+    __m256i a =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + offset));
+    __m256i b =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + offset + 32));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + offset),
+                        _mm256_shuffle_epi8(a, mask));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + offset + 32),
+                        _mm256_shuffle_epi8(b, mask));
+  }
+  for (; offset + 32 <= size; offset += 32) {
+    __m256i v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + offset));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + offset),
+                        _mm256_shuffle_epi8(v, mask));
+  }
+  return offset;
+}
+
+size_t SwapBytesVector(const uint8_t* in,
+                       uint8_t* out,
+                       size_t size,
+                       size_t width) {
+  static const bool has_avx2 = __builtin_cpu_supports("avx2");
+  static const bool has_ssse3 = __builtin_cpu_supports("ssse3");
+  if (has_avx2) {
+    return SwapBytesAVX2(in, out, size, width);
+  }
+  if (has_ssse3) {
+    return SwapBytesSSSE3(in, out, size, width);
+  }
+  return 0;
+}
+
+#elif defined(ARCH_CPU_ARM64)
+
+size_t SwapBytesVector(const uint8_t* in,
+                       uint8_t* out,
+                       size_t size,
+                       size_t width) {
+  size_t offset = 0;
+  for (; offset + 16 <= size; offset += 16) {
+    uint8x16_t v = vld1q_u8(in + offset);
+    switch (width) {
+      case 2:
+        v = vrev16q_u8(v);
+        break;
+      case 4:
+        v = vrev32q_u8(v);
+        break;
+      default:
+        v = vrev64q_u8(v);
+        break;
+    }
+    vst1q_u8(out + offset, v);
+  }
+  return offset;
+}
+
+#else
+
+size_t SwapBytesVector(const uint8_t* in,
+                       uint8_t* out,
+                       size_t size,
+                       size_t width) {
+  return 0;
+}
+
+#endif
+
+}  // namespace
+
+void SwapBytesBulk(std::span<const uint8_t> in,
+                   std::span<uint8_t> out,
+                   size_t width) {
+  CHECK_EQ(in.size(), out.size());
+  DCHECK(width == 2 || width == 4 || width == 8);
+  DCHECK_EQ(in.size() % width, 0u);
+  DCHECK(in.data() == out.data() || in.data() + in.size() <= out.data() ||
+         out.data() + out.size() <= in.data());
+
+  size_t done = SwapBytesVector(in.data(), out.data(), in.size(), width);
+  const uint8_t* in_rest = in.data() + done;
+  uint8_t* out_rest = out.data() + done;
+  size_t rest = in.size() - done;
+  switch (width) {
+    case 2:
+      SwapBytesScalar<uint16_t>(in_rest, out_rest, rest);
+      break;
+    case 4:
+      SwapBytesScalar<uint32_t>(in_rest, out_rest, rest);
+      break;
+    default:
+      SwapBytesScalar<uint64_t>(in_rest, out_rest, rest);
+      break;
+  }
+}
+
+}  // namespace base::numerics::internal
@@ -7,12 +7,14 @@
 
 #include <array>
 #include <bit>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <span>
 #include <type_traits>
 
 #include "base/numerics/basic_ops_impl.h"
+#include "base/numerics/safe_conversions_impl.h"
 #include "build/build_config.h"
 
 // Chromium only builds and runs on Little Endian machines.
@@ -437,6 +439,150 @@ inline constexpr std::array<uint8_t, 8u> DoubleToBigEndian(double val) {
   return internal::ToLittleEndian(ByteSwap(std::bit_cast<uint64_t>(val)));
 }
 
+namespace internal {
+
+// Reverses the byte order of each `width`-byte value in `in`, writing the
+// results to `out`. `in` and `out` must be the same size, a multiple of
+// `width`, and either the same memory or not overlapping. Uses SIMD byte
+// shuffles where the CPU has them.
+void SwapBytesBulk(std::span<const uint8_t> in,
+                   std::span<uint8_t> out,
+                   size_t width);
+
+template <class T>
+  requires(std::is_unsigned_v<T> && std::is_integral_v<T>)
+inline constexpr void FromEndianBulk(std::span<const uint8_t> bytes,
+                                     std::span<T> values,
+                                     bool big_endian) {
+  if (bytes.size() != values.size() * sizeof(T)) {
+    base::internal::CheckOnFailure::HandleFailure<void>();
+  }
+  if (std::is_constant_evaluated()) {
+    for (size_t i = 0u; i < values.size(); ++i) {
+      T value = FromLittleEndian<T>(
+          bytes.subspan(i * sizeof(T)).template first<sizeof(T)>());
+      values[i] = big_endian ? SwapBytes(value) : value;
+    }
+    return;
+  }
+  std::span<uint8_t> out(reinterpret_cast<uint8_t*>(values.data()),
+                         bytes.size());
+  if (big_endian && sizeof(T) > 1u) {
+    SwapBytesBulk(bytes, out, sizeof(T));
+  } else if (!bytes.empty()) {
+    memmove(out.data(), bytes.data(), bytes.size());
+  }
+}
+
+template <class T>
+  requires(std::is_unsigned_v<T> && std::is_integral_v<T>)
+inline constexpr void ToEndianBulk(std::span<const T> values,
+                                   std::span<uint8_t> bytes,
+                                   bool big_endian) {
+  if (bytes.size() != values.size() * sizeof(T)) {
+    base::internal::CheckOnFailure::HandleFailure<void>();
+  }
+  if (std::is_constant_evaluated()) {
+    for (size_t i = 0u; i < values.size(); ++i) {
+      std::array<uint8_t, sizeof(T)> encoded =
+          ToLittleEndian(big_endian ? SwapBytes(values[i]) : values[i]);
+      for (size_t j = 0u; j < sizeof(T); ++j) {
+        bytes[i * sizeof(T) + j] = encoded[j];
+      }
+    }
+    return;
+  }
+  std::span<const uint8_t> in(reinterpret_cast<const uint8_t*>(values.data()),
+                              bytes.size());
+  if (big_endian && sizeof(T) > 1u) {
+    SwapBytesBulk(in, bytes, sizeof(T));
+  } else if (!bytes.empty()) {
+    memmove(bytes.data(), in.data(), bytes.size());
+  }
+}
+
+}  // namespace internal
+
+// Bulk conversions between arrays of integers and their byte encodings. Each
+// is equivalent to calling the single-value function above for every element,
+// but converts many values per instruction where the CPU supports it (SSSE3
+// or AVX2 byte shuffles on x86, and REV on ARM64).
+//
+// `bytes` must hold exactly `values.size()` encoded integers, or the call
+// crashes. The two spans may be the same memory, to convert in place, but must
+// not otherwise overlap.
+
+// Decodes big-endian integers from `bytes` into `values`.
+inline constexpr void U16sFromBigEndian(std::span<const uint8_t> bytes,
+                                        std::span<uint16_t> values) {
+  internal::FromEndianBulk(bytes, values, /*big_endian=*/true);
+}
+inline constexpr void U32sFromBigEndian(std::span<const uint8_t> bytes,
+                                        std::span<uint32_t> values) {
+  internal::FromEndianBulk(bytes, values, /*big_endian=*/true);
+}
+inline constexpr void U64sFromBigEndian(std::span<const uint8_t> bytes,
+                                        std::span<uint64_t> values) {
+  internal::FromEndianBulk(bytes, values, /*big_endian=*/true);
+}
+
+// Decodes little-endian integers from `bytes` into `values`.
+inline constexpr void U16sFromLittleEndian(std::span<const uint8_t> bytes,
+                                           std::span<uint16_t> values) {
+  internal::FromEndianBulk(bytes, values, /*big_endian=*/false);
+}
+inline constexpr void U32sFromLittleEndian(std::span<const uint8_t> bytes,
+                                           std::span<uint32_t> values) {
+  internal::FromEndianBulk(bytes, values, /*big_endian=*/false);
+}
+inline constexpr void U64sFromLittleEndian(std::span<const uint8_t> bytes,
+                                           std::span<uint64_t> values) {
+  internal::FromEndianBulk(bytes, values, /*big_endian=*/false);
+}
+
+// Encodes `values` into `bytes` as big-endian integers.
+inline constexpr void U16sToBigEndian(std::span<const uint16_t> values,
+                                      std::span<uint8_t> bytes) {
+  internal::ToEndianBulk(values, bytes, /*big_endian=*/true);
+}
+inline constexpr void U32sToBigEndian(std::span<const uint32_t> values,
+                                      std::span<uint8_t> bytes) {
+  internal::ToEndianBulk(values, bytes, /*big_endian=*/true);
+}
+inline constexpr void U64sToBigEndian(std::span<const uint64_t> values,
+                                      std::span<uint8_t> bytes) {
+  internal::ToEndianBulk(values, bytes, /*big_endian=*/true);
+}
+
+// Encodes `values` into `bytes` as little-endian integers.
+inline constexpr void U16sToLittleEndian(std::span<const uint16_t> values,
+                                         std::span<uint8_t> bytes) {
+  internal::ToEndianBulk(values, bytes, /*big_endian=*/false);
+}
+inline constexpr void U32sToLittleEndian(std::span<const uint32_t> values,
+                                         std::span<uint8_t> bytes) {
+  internal::ToEndianBulk(values, bytes, /*big_endian=*/false);
+}
+inline constexpr void U64sToLittleEndian(std::span<const uint64_t> values,
+                                         std::span<uint8_t> bytes) {
+  internal::ToEndianBulk(values, bytes, /*big_endian=*/false);
+}
+
+// Reverses the byte order of every integer in `values`.
+template <class T>
+  requires(std::is_integral_v<T>)
+inline constexpr void ByteSwapInPlace(std::span<T> values) {
+  if (std::is_constant_evaluated() || sizeof(T) == 1u) {
+    for (T& value : values) {
+      value = ByteSwap(value);
+    }
+    return;
+  }
+  std::span<uint8_t> bytes(reinterpret_cast<uint8_t*>(values.data()),
+                           values.size_bytes());
+  internal::SwapBytesBulk(bytes, bytes, sizeof(T));
+}
+
 }  // namespace base::numerics
 
 #endif  //  MINI_CHROMIUM_BASE_NUMERICS_BYTE_CONVERSIONS_H_
@@ -0,0 +1,157 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/numerics/varint.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "build/build_config.h"
+
+#if defined(ARCH_CPU_X86_FAMILY) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace base::numerics {
+
+namespace {
+
+// The block of bytes whose continuation bits are examined at once.
+constexpr size_t kBlockSize = 16;
+
+// The fast path loads a word from any varint that starts in the block, so it
+// needs this many bytes available past the start of the block.
+constexpr size_t kFastPathBytes = kBlockSize + sizeof(uint64_t);
+
+uint64_t LoadWord(const uint8_t* bytes) {
+  // Little endian, as Chromium only builds for little-endian machines.
+  uint64_t word;
+  memcpy(&word, bytes, sizeof(word));
+  return word;
+}
+
+// Returns a mask with bit i set if byte i of the block at `bytes` has its
+// continuation bit set.
+uint32_t ContinuationMask(const uint8_t* bytes) {
+#if defined(ARCH_CPU_X86_FAMILY) && defined(__SSE2__)
+  return static_cast<uint32_t>(_mm_movemask_epi8(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes))));
+#else
+  // Gathers the high bit of each byte of a word into the top byte of the
+  // product: after the shift, the bit for byte i is at 8 * i, and the
+  // multiplier moves it to 56 + i. No two partial products overlap, so there
+  // are no carries.
+  auto word_mask = [](uint64_t word) {
+    constexpr uint64_t kHighBits = 0x8080808080808080u;
+    constexpr uint64_t kGather = 0x0102040810204080u;
+    return static_cast<uint32_t>(((word & kHighBits) >> 7) * kGather >> 56);
+  };
+  return word_mask(LoadWord(bytes)) |
+         word_mask(LoadWord(bytes + sizeof(uint64_t))) << 8;
+#endif
+}
+
+// Returns the value of the varint of `size` bytes, from one to eight, held in
+// the low bytes of `word`. The seven-bit groups are packed together in three
+// steps, doubling their width each time, rather than one byte at a time.
+uint64_t DecodeWord(uint64_t word, size_t size) {
+  uint64_t x = word & 0x7f7f7f7f7f7f7f7fu & (~uint64_t{0} >> (64 - 8 * size));
+  x = (x & 0x007f007f007f007fu) | ((x & 0x7f007f007f007f00u) >> 1);
+  x = (x & 0x00003fff00003fffu) | ((x & 0x3fff00003fff0000u) >> 2);
+  x = (x & 0x000000000fffffffu) | ((x & 0x0fffffff00000000u) >> 4);
+  return x;
+}
+
+}  // namespace
+
+CheckedNumeric<size_t> DecodeVarints(std::span<const uint8_t> bytes,
+                                     std::span<uint64_t> values) {
+  const uint8_t* data = bytes.data();
+  uint64_t* out = values.data();
+  size_t position = 0;
+  size_t count = 0;
+
+  while (count < values.size() && bytes.size() - position >= kFastPathBytes) {
+    const uint8_t* block = data + position;
+    uint32_t continuations = ContinuationMask(block);
+
+    if (continuations == 0 && values.size() - count >= kBlockSize) {
+      // Sixteen one-byte varints. This loop is vectorized.
+      for (size_t i = 0; i < kBlockSize; ++i) {
+        out[count + i] = block[i];
+      }
+      position += kBlockSize;
+      count += kBlockSize;
+      continue;
+    }
+
+    // Each clear bit ends a varint. The varints ending in this block are
+    // decoded from their lengths; one that continues past the block is left
+    // for the next iteration, which starts at its first byte.
+    uint32_t ends = ~continuations & ((1u << kBlockSize) - 1);
+    if (!ends) {
+      // Longer than any 64-bit varint.
+      return CheckedNumeric<size_t>(-1);
+    }
+    size_t start = 0;
+    do {
+      size_t end = static_cast<size_t>(std::countr_zero(ends));
+      size_t size = end + 1 - start;
+      uint64_t value =
+          DecodeWord(LoadWord(block + start), std::min(size, sizeof(uint64_t)));
+      if (size > sizeof(uint64_t)) [[unlikely]] {
+        // The ninth byte holds bits 56 to 62, and the tenth holds only bit 63.
+        if (size > kMaxVarintSize ||
+            (size == kMaxVarintSize && block[end] > 1)) {
+          return CheckedNumeric<size_t>(-1);
+        }
+        value |= uint64_t{block[start + 8] & 0x7fu} << 56;
+        if (size == kMaxVarintSize) {
+          value |= uint64_t{block[end]} << 63;
+        }
+      }
+      out[count] = value;
+      ++count;
+      start = end + 1;
+      ends &= ends - 1;
+    } while (ends && count < values.size());
+    position += start;
+  }
+
+  while (count < values.size()) {
+    size_t size;
+    if (!DecodeVarint(bytes.subspan(position), size)
+             .AssignIfValid(&out[count])) {
+      return CheckedNumeric<size_t>(-1);
+    }
+    position += size;
+    ++count;
+  }
+  return position;
+}
+
+CheckedNumeric<size_t> EncodeVarints(std::span<const uint64_t> values,
+                                     std::span<uint8_t> bytes) {
+  uint8_t* data = bytes.data();
+  size_t position = 0;
+  for (uint64_t value : values) {
+    if (bytes.size() - position >= kMaxVarintSize) {
+      position += EncodeVarint(
+          value, std::span<uint8_t, kMaxVarintSize>(data + position,
+                                                    kMaxVarintSize));
+      continue;
+    }
+    uint8_t encoded[kMaxVarintSize];
+    size_t size = EncodeVarint(value, encoded);
+    if (size > bytes.size() - position) {
+      return CheckedNumeric<size_t>(-1);
+    }
+    memcpy(data + position, encoded, size);
+    position += size;
+  }
+  return position;
+}
+
+}  // namespace base::numerics
@@ -0,0 +1,128 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MINI_CHROMIUM_BASE_NUMERICS_VARINT_H_
+#define MINI_CHROMIUM_BASE_NUMERICS_VARINT_H_
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "base/numerics/checked_math.h"
+
+namespace base::numerics {
+
+// Variable-length integer encodings, as used by protocol buffers, WebAssembly
+// and DWARF.
+//
+// An unsigned LEB128 varint stores an integer seven bits at a time, least
+// significant group first, in the low bits of each byte. The high bit of each
+// byte is set when another byte follows. Values below 128 take one byte, and a
+// 64-bit value takes at most kMaxVarintSize bytes.
+//
+// Signed values are stored as the varint of their zigzag encoding, which maps
+// small negative numbers to small unsigned numbers (0, -1, 1, -2, ... become
+// 0, 1, 2, 3, ...) so that they stay short.
+//
+// Decoding reports malformed input through CheckedNumeric: the result is
+// invalid if the input ends in the middle of a varint, or if the encoded value
+// does not fit in 64 bits. A valid result can be narrowed safely with
+// AssignIfValid() or Cast<>().
+
+// The longest unsigned LEB128 encoding of a 64-bit value.
+inline constexpr size_t kMaxVarintSize = 10u;
+
+// Returns the number of bytes in the varint encoding of `value`.
+inline constexpr size_t VarintSize(uint64_t value) {
+  return (static_cast<size_t>(std::bit_width(value | 1u)) + 6u) / 7u;
+}
+
+// Returns the zigzag encoding of `value`.
+inline constexpr uint64_t ZigZagEncode(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^
+         static_cast<uint64_t>(value >> 63);
+}
+
+// Returns the value whose zigzag encoding is `value`.
+inline constexpr int64_t ZigZagDecode(uint64_t value) {
+  return static_cast<int64_t>((value >> 1) ^ (0u - (value & 1u)));
+}
+
+// Writes the varint encoding of `value` to the front of `bytes`, and returns
+// the number of bytes written, which is VarintSize(value).
+inline constexpr size_t EncodeVarint(uint64_t value,
+                                     std::span<uint8_t, kMaxVarintSize> bytes) {
+  size_t size = 0u;
+  while (value >= 0x80u) {
+    bytes[size++] = static_cast<uint8_t>(value | 0x80u);
+    value >>= 7u;
+  }
+  bytes[size++] = static_cast<uint8_t>(value);
+  return size;
+}
+
+// Writes the varint encoding of ZigZagEncode(`value`) to the front of
+// `bytes`, and returns the number of bytes written.
+inline constexpr size_t EncodeSignedVarint(
+    int64_t value,
+    std::span<uint8_t, kMaxVarintSize> bytes) {
+  return EncodeVarint(ZigZagEncode(value), bytes);
+}
+
+// Decodes the varint at the front of `bytes`, and sets `size` to the number
+// of bytes it took up. If the result is invalid, `size` is 0.
+inline constexpr CheckedNumeric<uint64_t> DecodeVarint(
+    std::span<const uint8_t> bytes,
+    size_t& size) {
+  CheckedNumeric<uint64_t> result = 0u;
+  for (size_t i = 0u; i < bytes.size() && i < kMaxVarintSize; ++i) {
+    // CheckLsh() is invalid if any bits are shifted out, which catches values
+    // over 64 bits in the last byte.
+    result |= CheckLsh(uint64_t{bytes[i] & 0x7fu}, 7u * i);
+    if (!(bytes[i] & 0x80u)) {
+      size = result.IsValid() ? i + 1u : 0u;
+      return result;
+    }
+  }
+  size = 0u;
+  // The varint is truncated, or longer than any 64-bit value needs. A
+  // negative value is out of range for the result, so this is invalid.
+  return CheckedNumeric<uint64_t>(-1);
+}
+
+// Decodes the signed varint at the front of `bytes`, and sets `size` to the
+// number of bytes it took up. If the result is invalid, `size` is 0.
+inline constexpr CheckedNumeric<int64_t> DecodeSignedVarint(
+    std::span<const uint8_t> bytes,
+    size_t& size) {
+  CheckedNumeric<uint64_t> result = DecodeVarint(bytes, size);
+  uint64_t value;
+  if (!result.AssignIfValid(&value)) {
+    return CheckedNumeric<int64_t>(result);
+  }
+  return ZigZagDecode(value);
+}
+
+// Decodes `values.size()` consecutive varints from the front of `bytes` into
+// `values`, and returns the number of bytes they took up. The result is
+// invalid if any of the varints are, and the contents of `values` are then
+// unspecified.
+//
+// This is much faster than calling DecodeVarint() in a loop: it finds the
+// ends of the varints in 16-byte blocks at a time with a SIMD byte mask,
+// widens blocks of one-byte varints in bulk, and assembles varints of up to
+// eight bytes from a single word load without a loop over their bytes.
+CheckedNumeric<size_t> DecodeVarints(std::span<const uint8_t> bytes,
+                                     std::span<uint64_t> values);
+
+// Encodes `values` as consecutive varints at the front of `bytes`, and returns
+// the number of bytes written. The result is invalid if `bytes` is too small,
+// and the contents of `bytes` are then unspecified.
+CheckedNumeric<size_t> EncodeVarints(std::span<const uint64_t> values,
+                                     std::span<uint8_t> bytes);
+
+}  // namespace base::numerics
+
+#endif  // MINI_CHROMIUM_BASE_NUMERICS_VARINT_H_
@@ -0,0 +1,73 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/rand_sampling.h"
+
+#include <cmath>
+
+namespace base {
+
+AliasTable::AliasTable(span<const double> weights) {
+  CHECK(!weights.empty());
+  const size_t size = weights.size();
+
+  double total = 0;
+  size_t heaviest = 0;
+  for (size_t i = 0; i < size; ++i) {
+    CHECK(std::isfinite(weights[i]));
+    CHECK_GE(weights[i], 0.0);
+    total += weights[i];
+    if (weights[i] > weights[heaviest]) {
+      heaviest = i;
+    }
+  }
+  CHECK(std::isfinite(total));
+  CHECK_GT(total, 0.0);
+
+  // Scale each weight so that the average is 1, then repeatedly pair a column
+  // below 1 ("small") with one at or above 1 ("large"), topping the small one
+  // up with the large one's excess.
+  std::vector<double> scaled(size);
+  std::vector<size_t> small;
+  std::vector<size_t> large;
+  for (size_t i = 0; i < size; ++i) {
+    scaled[i] = weights[i] * static_cast<double>(size) / total;
+    (scaled[i] < 1.0 ? small : large).push_back(i);
+  }
+
+  constexpr double kThresholdScale = 0x1.0p53;
+  columns_.resize(size);
+  while (!small.empty() && !large.empty()) {
+    size_t less = small.back();
+    small.pop_back();
+    size_t more = large.back();
+    columns_[less].threshold =
+        static_cast<uint64_t>(scaled[less] * kThresholdScale);
+    columns_[less].alias = more;
+    scaled[more] = (scaled[more] + scaled[less]) - 1.0;
+    if (scaled[more] < 1.0) {
+      large.pop_back();
+      small.push_back(more);
+    }
+  }
+
+  // Whatever remains is 1 up to rounding error, and always chooses itself,
+  // except that a column for a weight of 0, left over when rounding ran out
+  // the large columns early, must never choose itself.
+  for (size_t i : large) {
+    columns_[i] = {static_cast<uint64_t>(kThresholdScale), i};
+  }
+  for (size_t i : small) {
+    columns_[i] = weights[i] > 0.0
+                      ? Column{static_cast<uint64_t>(kThresholdScale), i}
+                      : Column{0, heaviest};
+  }
+}
+
+AliasTable::AliasTable(AliasTable&&) = default;
+AliasTable& AliasTable::operator=(AliasTable&&) = default;
+
+AliasTable::~AliasTable() = default;
+
+}  // namespace base
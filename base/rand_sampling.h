@@ -0,0 +1,190 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MINI_CHROMIUM_BASE_RAND_SAMPLING_H_
+#define MINI_CHROMIUM_BASE_RAND_SAMPLING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "base/check_op.h"
+#include "base/containers/span.h"
+#include "base/rand_util.h"
+
+// Random sampling utilities. Each of these draws its randomness from a
+// generator: any callable returning uniformly distributed uint64_t values,
+// such as base::RandUint64 (cryptographically strong) or an
+// InsecureRandomGenerator (fast, and reproducible in tests).
+
+namespace base {
+
+namespace internal {
+
+// Returns a value uniformly distributed in the open interval (0, 1), which is
+// safe to take the logarithm of.
+template <typename Generator>
+double RandOpenUnitInterval(Generator&& generator) {
+  return (static_cast<double>(generator() >> 11) + 0.5) * 0x1.0p-53;
+}
+
+}  // namespace internal
+
+// Shuffles |items| uniformly at random (Fisher-Yates). Every permutation is
+// equally likely, given an unbiased generator.
+template <typename T, size_t N, typename Generator>
+void ShuffleSpan(span<T, N> items, Generator&& generator) {
+  T* data = items.data();
+  for (size_t i = items.size(); i > 1; --i) {
+    size_t j = static_cast<size_t>(internal::RandGeneratorWith(i, generator));
+    using std::swap;
+    swap(data[i - 1], data[j]);
+  }
+}
+
+// Draws indices with probability proportional to a fixed set of weights, in
+// O(1) per draw after O(n) construction (Walker's alias method, with Vose's
+// numerically stable construction).
+//
+//   base::AliasTable table(weights);
+//   size_t index = table.Sample(base::RandUint64);
+class AliasTable {
+ public:
+  // |weights| must be non-empty, and contain only finite, non-negative values,
+  // at least one of which is positive. Indices with weight 0 are never drawn.
+  explicit AliasTable(span<const double> weights);
+
+  AliasTable(const AliasTable&) = delete;
+  AliasTable& operator=(const AliasTable&) = delete;
+
+  AliasTable(AliasTable&&);
+  AliasTable& operator=(AliasTable&&);
+
+  ~AliasTable();
+
+  // Returns an index into the weights the table was built from.
+  template <typename Generator>
+  size_t Sample(Generator&& generator) const {
+    size_t column = static_cast<size_t>(
+        internal::RandGeneratorWith(columns_.size(), generator));
+    // Compare the top 53 bits of a draw with the column's threshold, which
+    // was scaled to the same range.
+    uint64_t coin = generator() >> 11;
+    const Column& entry = columns_[column];
+    return coin < entry.threshold ? column : entry.alias;
+  }
+
+  size_t size() const { return columns_.size(); }
+
+ private:
+  struct Column {
+    // The column itself is chosen when a 53-bit draw is below this, and
+    // |alias| is chosen otherwise.
+    uint64_t threshold;
+    size_t alias;
+  };
+
+  std::vector<Column> columns_;
+};
+
+// Maintains a uniform random sample of up to |capacity| items from a stream
+// of unknown length, using Li's Algorithm L: rather than drawing a random
+// number for every item, it computes how many items to skip before the next
+// one enters the sample, so the cost per item is a counter comparison, and
+// random draws are only made O(capacity * log(items / capacity)) times.
+//
+//   base::ReservoirSampler<Request> sampler(100);
+//   for (...)
+//     sampler.Add(request, generator);
+//   Report(sampler.samples());
+template <typename T>
+class ReservoirSampler {
+ public:
+  explicit ReservoirSampler(size_t capacity) : capacity_(capacity) {
+    CHECK_GT(capacity, 0u);
+    samples_.reserve(capacity);
+  }
+
+  ReservoirSampler(const ReservoirSampler&) = delete;
+  ReservoirSampler& operator=(const ReservoirSampler&) = delete;
+
+  // Offers |item| to the sample. |generator| is only called when the item is
+  // accepted, or the sample becomes full.
+  template <typename Generator>
+  void Add(T item, Generator&& generator) {
+    ++items_seen_;
+    if (samples_.size() < capacity_) {
+      samples_.push_back(std::move(item));
+      if (samples_.size() == capacity_) {
+        weight_ = NextWeight(1.0, generator);
+        ScheduleNextAccept(generator);
+      }
+      return;
+    }
+    if (items_seen_ != next_accept_) {
+      return;
+    }
+    size_t victim = static_cast<size_t>(
+        internal::RandGeneratorWith(capacity_, generator));
+    samples_[victim] = std::move(item);
+    weight_ = NextWeight(weight_, generator);
+    ScheduleNextAccept(generator);
+  }
+
+  // The current sample, in no particular order. Holds min(capacity,
+  // items_seen()) items.
+  span<const T> samples() const { return samples_; }
+
+  // Returns the sample and resets the sampler to its initial state.
+  std::vector<T> TakeSamples() {
+    std::vector<T> samples = std::exchange(samples_, std::vector<T>());
+    samples_.reserve(capacity_);
+    items_seen_ = 0;
+    next_accept_ = 0;
+    return samples;
+  }
+
+  size_t capacity() const { return capacity_; }
+  uint64_t items_seen() const { return items_seen_; }
+
+ private:
+  template <typename Generator>
+  double NextWeight(double weight, Generator&& generator) const {
+    return weight *
+           std::exp(std::log(internal::RandOpenUnitInterval(generator)) /
+                    static_cast<double>(capacity_));
+  }
+
+  template <typename Generator>
+  void ScheduleNextAccept(Generator&& generator) {
+    double skip =
+        std::floor(std::log(internal::RandOpenUnitInterval(generator)) /
+                   std::log1p(-weight_));
+    // Once the stream is long enough, the skip can exceed anything a counter
+    // will reach.
+    constexpr double kMaxSkip = 0x1.0p62;
+    next_accept_ = skip < kMaxSkip
+                       ? items_seen_ + static_cast<uint64_t>(skip) + 1
+                       : std::numeric_limits<uint64_t>::max();
+  }
+
+  const size_t capacity_;
+  std::vector<T> samples_;
+  uint64_t items_seen_ = 0;
+
+  // The 1-based position in the stream of the next item to enter the sample,
+  // once the sample is full.
+  uint64_t next_accept_ = 0;
+
+  // Algorithm L's W: the largest of |capacity_| uniform keys in the sample.
+  double weight_ = 0;
+};
+
+}  // namespace base
+
+#endif  // MINI_CHROMIUM_BASE_RAND_SAMPLING_H_
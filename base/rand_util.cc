@@ -8,6 +8,7 @@
 #include <string.h>
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <limits>
 
@@ -19,7 +20,15 @@
 #include <zircon/syscalls.h>
 #include "base/fuchsia/fuchsia_logging.h"
 #elif BUILDFLAG(IS_POSIX)
+#include <pthread.h>
+#include <sys/mman.h>
+
+#include <atomic>
+
+#include "base/memory/page_size.h"
+#include "base/numerics/byte_conversions.h"
 #include "base/posix/eintr_wrapper.h"
+#include "base/threading/thread_local_storage.h"
 #elif BUILDFLAG(IS_WIN)
 #include <windows.h>
 
@@ -32,6 +41,11 @@
 
 #endif  // BUILDFLAG(IS_WIN)
 
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) || BUILDFLAG(IS_ANDROID)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 #if BUILDFLAG(IS_POSIX) && !BUILDFLAG(IS_FUCHSIA)
 
 namespace {
@@ -47,6 +61,185 @@ int GetUrandomFD() {
   return fd;
 }
 
+// Fills |output| from the kernel: getrandom() where available, and
+// /dev/urandom otherwise.
+void KernelRandBytes(uint8_t* output, size_t size) {
+#if defined(SYS_getrandom)
+  static std::atomic<bool> getrandom_unavailable(false);
+  while (size > 0 && !getrandom_unavailable.load(std::memory_order_relaxed)) {
+    long bytes = HANDLE_EINTR(syscall(SYS_getrandom, output, size, 0));
+    if (bytes < 0) {
+      // ENOSYS on old kernels, and EPERM (or anything else) from seccomp
+      // filters that predate getrandom(); /dev/urandom still works there.
+      getrandom_unavailable.store(true, std::memory_order_relaxed);
+      break;
+    }
+    output += bytes;
+    size -= bytes;
+  }
+  if (size == 0) {
+    return;
+  }
+#endif  // defined(SYS_getrandom)
+  CHECK(base::ReadFromFD(GetUrandomFD(), reinterpret_cast<char*>(output),
+                         size));
+}
+
+// Requests up to this size are served from a per-thread ChaCha20 generator
+// without a system call. Larger requests go to the kernel, which is just as
+// fast per byte for them.
+constexpr size_t kMaxBufferedRequest = 256;
+
+constexpr size_t kChaChaBlockSize = 64;
+constexpr size_t kChaChaKeySize = 32;
+constexpr size_t kBufferBlocks = 32;
+
+inline uint32_t RotateLeft(uint32_t value, int bits) {
+  return (value << bits) | (value >> (32 - bits));
+}
+
+inline void QuarterRound(uint32_t* x, int a, int b, int c, int d) {
+  x[a] += x[b];
+  x[d] = RotateLeft(x[d] ^ x[a], 16);
+  x[c] += x[d];
+  x[b] = RotateLeft(x[b] ^ x[c], 12);
+  x[a] += x[b];
+  x[d] = RotateLeft(x[d] ^ x[a], 8);
+  x[c] += x[d];
+  x[b] = RotateLeft(x[b] ^ x[c], 7);
+}
+
+// Writes ChaCha20 (RFC 8439) block number |counter| for |key| and an all-zero
+// nonce to |output|.
+void ChaCha20Block(const uint32_t key[8], uint32_t counter, uint8_t* output) {
+  const uint32_t input[16] = {
+      0x61707865, 0x3320646e, 0x79622d32, 0x6b206574,  // "expand 32-byte k"
+      key[0],     key[1],     key[2],     key[3],
+      key[4],     key[5],     key[6],     key[7],
+      counter,    0,          0,          0,
+  };
+  uint32_t x[16];
+  memcpy(x, input, sizeof(x));
+  for (int round = 0; round < 20; round += 2) {
+    QuarterRound(x, 0, 4, 8, 12);
+    QuarterRound(x, 1, 5, 9, 13);
+    QuarterRound(x, 2, 6, 10, 14);
+    QuarterRound(x, 3, 7, 11, 15);
+    QuarterRound(x, 0, 5, 10, 15);
+    QuarterRound(x, 1, 6, 11, 12);
+    QuarterRound(x, 2, 7, 8, 13);
+    QuarterRound(x, 3, 4, 9, 14);
+  }
+  for (size_t i = 0; i < std::size(x); ++i) {
+    std::array<uint8_t, 4> word =
+        base::numerics::U32ToLittleEndian(x[i] + input[i]);
+    memcpy(output + i * sizeof(word), word.data(), sizeof(word));
+  }
+}
+
+// Incremented in the child after fork(), so that a child never continues a
+// stream that its parent (or a sibling) also continues.
+std::atomic<uint32_t> g_fork_generation(0);
+
+void OnForkChild() {
+  g_fork_generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+// The state of one thread's generator. This uses "fast key erasure": each
+// refill generates a buffer of keystream, the first kChaChaKeySize bytes of
+// which immediately replace the key, and bytes are wiped from the buffer as
+// they are handed out. A compromise of the state therefore reveals nothing
+// about output that has already been returned.
+//
+// The state lives in its own mapping. Where the kernel supports
+// MADV_WIPEONFORK, a child process sees it zeroed, and so unseeded, even if it
+// was created by a raw clone() that bypassed the pthread_atfork() handler.
+struct ThreadRandState {
+  bool seeded;
+  uint32_t fork_generation;
+  uint32_t key[kChaChaKeySize / sizeof(uint32_t)];
+  size_t available;
+  uint8_t buffer[kBufferBlocks * kChaChaBlockSize];
+};
+
+size_t ThreadRandStateMappingSize() {
+  size_t page_size = base::GetPageSize();
+  return (sizeof(ThreadRandState) + page_size - 1) / page_size * page_size;
+}
+
+void FreeThreadRandState(void* value) {
+  ThreadRandState* state = static_cast<ThreadRandState*>(value);
+  memset(state, 0, sizeof(*state));
+  munmap(state, ThreadRandStateMappingSize());
+}
+
+// Returns this thread's generator state, or nullptr if it can't be created.
+ThreadRandState* GetThreadRandState() {
+  static base::ThreadLocalStorage::Slot* slot = [] {
+    pthread_atfork(nullptr, nullptr, &OnForkChild);
+    return new base::ThreadLocalStorage::Slot(&FreeThreadRandState);
+  }();
+  ThreadRandState* state = static_cast<ThreadRandState*>(slot->Get());
+  if (state) {
+    return state;
+  }
+  void* mapping = mmap(nullptr, ThreadRandStateMappingSize(),
+                       PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+                       -1, 0);
+  if (mapping == MAP_FAILED) {
+    return nullptr;
+  }
+#if defined(MADV_WIPEONFORK)
+  // Failure means an older kernel; the pthread_atfork() handler still covers
+  // ordinary fork().
+  madvise(mapping, ThreadRandStateMappingSize(), MADV_WIPEONFORK);
+#endif
+  state = static_cast<ThreadRandState*>(mapping);
+  slot->Set(state);
+  return state;
+}
+
+void Refill(ThreadRandState* state) {
+  for (size_t block = 0; block < kBufferBlocks; ++block) {
+    ChaCha20Block(state->key, static_cast<uint32_t>(block),
+                  state->buffer + block * kChaChaBlockSize);
+  }
+  memcpy(state->key, state->buffer, kChaChaKeySize);
+  memset(state->buffer, 0, kChaChaKeySize);
+  state->available = sizeof(state->buffer) - kChaChaKeySize;
+}
+
+// Fills |output|, which must be no larger than kMaxBufferedRequest, from the
+// calling thread's generator. Returns false if the generator is unavailable.
+bool ThreadRandBytes(uint8_t* output, size_t size) {
+  ThreadRandState* state = GetThreadRandState();
+  if (!state) {
+    return false;
+  }
+  uint32_t fork_generation = g_fork_generation.load(std::memory_order_relaxed);
+  if (!state->seeded || state->fork_generation != fork_generation) {
+    KernelRandBytes(reinterpret_cast<uint8_t*>(state->key),
+                    sizeof(state->key));
+    state->available = 0;
+    state->fork_generation = fork_generation;
+    state->seeded = true;
+  }
+  while (size > 0) {
+    if (state->available == 0) {
+      Refill(state);
+    }
+    size_t bytes = std::min(size, state->available);
+    uint8_t* source =
+        state->buffer + sizeof(state->buffer) - state->available;
+    memcpy(output, source, bytes);
+    memset(source, 0, bytes);
+    state->available -= bytes;
+    output += bytes;
+    size -= bytes;
+  }
+  return true;
+}
+
 }  // namespace
 
 #endif  // BUILDFLAG(IS_POSIX) && !BUILDFLAG(IS_FUCHSIA)
@@ -72,16 +265,7 @@ int RandInt(int min, int max) {
 
 uint64_t RandGenerator(uint64_t range) {
   DCHECK_GT(range, 0u);
-
-  uint64_t max_acceptable_value =
-      (std::numeric_limits<uint64_t>::max() / range) * range - 1;
-
-  uint64_t value;
-  do {
-    value = base::RandUint64();
-  } while (value > max_acceptable_value);
-
-  return value % range;
+  return internal::RandGeneratorWith(range, &base::RandUint64);
 }
 
 double RandDouble() {
@@ -112,10 +296,11 @@ void RandBytes(span<uint8_t> output) {
 #if BUILDFLAG(IS_FUCHSIA)
   zx_cprng_draw(output.data(), output.size());
 #elif BUILDFLAG(IS_POSIX)
-  int fd = GetUrandomFD();
-  bool success =
-      ReadFromFD(fd, reinterpret_cast<char*>(output.data()), output.size());
-  CHECK(success);
+  if (output.size() <= kMaxBufferedRequest &&
+      ThreadRandBytes(output.data(), output.size())) {
+    return;
+  }
+  KernelRandBytes(output.data(), output.size());
 #elif BUILDFLAG(IS_WIN)
   while (!output.empty()) {
     const ULONG output_bytes_this_pass = static_cast<ULONG>(std::min(
@@ -138,4 +323,168 @@ std::string RandBytesAsString(size_t length) {
   return result;
 }
 
+namespace {
+
+// SplitMix64, the generator recommended for expanding a seed into xoshiro
+// state.
+uint64_t SplitMix64(uint64_t* state) {
+  uint64_t z = (*state += 0x9e3779b97f4a7c15);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+  return z ^ (z >> 31);
+}
+
+// The number of streams that InsecureRandomGenerator::Fill() runs in
+// lockstep: four 64-bit lanes fill an AVX2 register.
+constexpr size_t kFillLanes = 4;
+
+// Fill() falls back to the scalar generator below this size, where seeding
+// the lanes would cost more than it saves.
+constexpr size_t kMinLanedFill = 64;
+
+// The state of kFillLanes xoshiro256** streams, laid out as four arrays of
+// lanes rather than an array of four-word states, so that each step is one
+// operation across all lanes.
+struct FillLanesState {
+  uint64_t s[4][kFillLanes];
+};
+
+uint64_t RotateLeft64(uint64_t value, int bits) {
+  return (value << bits) | (value >> (64 - bits));
+}
+
+// Writes |steps| * kFillLanes values to |out|, one from each lane per step.
+void FillLanesScalar(FillLanesState* state, uint64_t* out, size_t steps) {
+  uint64_t(&s)[4][kFillLanes] = state->s;
+  for (size_t i = 0; i < steps; ++i) {
+    for (size_t lane = 0; lane < kFillLanes; ++lane) {
+      out[i * kFillLanes + lane] = RotateLeft64(s[1][lane] * 5, 7) * 9;
+      uint64_t t = s[1][lane] << 17;
+      s[2][lane] ^= s[0][lane];
+      s[3][lane] ^= s[1][lane];
+      s[1][lane] ^= s[2][lane];
+      s[0][lane] ^= s[3][lane];
+      s[2][lane] ^= t;
+      s[3][lane] = RotateLeft64(s[3][lane], 45);
+    }
+  }
+}
+
+#if defined(ARCH_CPU_X86_64) && defined(COMPILER_GCC)
+
+// Compilers do not reliably vectorize FillLanesScalar(), so this spells out
+// the same computation with one vector per state word. It is compiled for
+// AVX2 regardless of the target baseline and selected at runtime.
+typedef uint64_t FillLanesVector
+    __attribute__((vector_size(kFillLanes * sizeof(uint64_t))));
+
+__attribute__((target("avx2"))) void FillLanesAVX2(FillLanesState* state,
+                                                   uint64_t* out,
+                                                   size_t steps) {
+  FillLanesVector s0, s1, s2, s3;
+  memcpy(&s0, state->s[0], sizeof(s0));
+  memcpy(&s1, state->s[1], sizeof(s1));
+  memcpy(&s2, state->s[2], sizeof(s2));
+  memcpy(&s3, state->s[3], sizeof(s3));
+  for (size_t i = 0; i < steps; ++i) {
+    // AVX2 has no 64-bit multiply, so multiply by 5 and 9 with shifts.
+    FillLanesVector scaled = s1 + (s1 << 2);
+    FillLanesVector rotated = (scaled << 7) | (scaled >> 57);
+    FillLanesVector result = rotated + (rotated << 3);
+    memcpy(out + i * kFillLanes, &result, sizeof(result));
+    FillLanesVector t = s1 << 17;
+    s2 ^= s0;
+    s3 ^= s1;
+    s1 ^= s2;
+    s0 ^= s3;
+    s2 ^= t;
+    s3 = (s3 << 45) | (s3 >> 19);
+  }
+  memcpy(state->s[0], &s0, sizeof(s0));
+  memcpy(state->s[1], &s1, sizeof(s1));
+  memcpy(state->s[2], &s2, sizeof(s2));
+  memcpy(state->s[3], &s3, sizeof(s3));
+}
+
+void FillLanes(FillLanesState* state, uint64_t* out, size_t steps) {
+  static const bool has_avx2 = __builtin_cpu_supports("avx2");
+  if (has_avx2) {
+    FillLanesAVX2(state, out, steps);
+  } else {
+    FillLanesScalar(state, out, steps);
+  }
+}
+
+#else
+
+void FillLanes(FillLanesState* state, uint64_t* out, size_t steps) {
+  FillLanesScalar(state, out, steps);
+}
+
+#endif  // defined(ARCH_CPU_X86_64) && defined(COMPILER_GCC)
+
+}  // namespace
+
+InsecureRandomGenerator::InsecureRandomGenerator() {
+  do {
+    RandBytes(as_writable_byte_span(state_));
+    // xoshiro256** must not be seeded with all zeroes.
+  } while (!(state_[0] | state_[1] | state_[2] | state_[3]));
+}
+
+void InsecureRandomGenerator::ReseedForTesting(uint64_t seed) {
+  for (uint64_t& word : state_) {
+    word = SplitMix64(&seed);
+  }
+}
+
+int InsecureRandomGenerator::RandInt(int min, int max) {
+  DCHECK_LE(min, max);
+  uint64_t range = static_cast<uint64_t>(max) - min + 1;
+  return min + static_cast<int>(RandGenerator(range));
+}
+
+void InsecureRandomGenerator::Fill(span<uint64_t> output) {
+  if (output.size() < kMinLanedFill) {
+    for (uint64_t& value : output) {
+      value = RandUint64();
+    }
+    return;
+  }
+
+  FillLanesState state;
+  for (size_t lane = 0; lane < kFillLanes; ++lane) {
+    uint64_t seed = RandUint64();
+    for (uint64_t(&word)[kFillLanes] : state.s) {
+      word[lane] = SplitMix64(&seed);
+    }
+  }
+
+  size_t full_steps = output.size() / kFillLanes;
+  FillLanes(&state, output.data(), full_steps);
+  if (size_t tail = output.size() % kFillLanes) {
+    uint64_t block[kFillLanes];
+    FillLanes(&state, block, 1);
+    memcpy(output.data() + full_steps * kFillLanes, block,
+           tail * sizeof(block[0]));
+  }
+}
+
+void InsecureRandomGenerator::Fill(span<double> output) {
+  // Generate bits a block at a time and convert them.
+  uint64_t bits[512];
+  while (!output.empty()) {
+    span<uint64_t> block =
+        span(bits).first(std::min(output.size(), std::size(bits)));
+    Fill(block);
+    // Indexing through the spans would bounds-check every element, which
+    // costs more than the conversion itself. |block| fits within |output|.
+    double* out = output.data();
+    for (size_t i = 0; i < block.size(); ++i) {
+      out[i] = ToDouble(bits[i]);
+    }
+    output = output.subspan(block.size());
+  }
+}
+
 }  // namespace base
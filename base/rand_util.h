@@ -13,6 +13,50 @@
 
 namespace base {
 
+namespace internal {
+
+// Returns the high 64 bits of the 128-bit product of |a| and |b|, and stores
+// the low 64 bits in |low|.
+inline uint64_t MultiplyHigh64(uint64_t a, uint64_t b, uint64_t* low) {
+#if defined(__SIZEOF_INT128__)
+  unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+  *low = static_cast<uint64_t>(product);
+  return static_cast<uint64_t>(product >> 64);
+#else
+  uint64_t a_low = a & 0xffffffff;
+  uint64_t a_high = a >> 32;
+  uint64_t b_low = b & 0xffffffff;
+  uint64_t b_high = b >> 32;
+  uint64_t low_low = a_low * b_low;
+  uint64_t high_low = a_high * b_low;
+  uint64_t low_high = a_low * b_high;
+  uint64_t middle = (low_low >> 32) + (high_low & 0xffffffff) + low_high;
+  *low = (middle << 32) | (low_low & 0xffffffff);
+  return a_high * b_high + (high_low >> 32) + (middle >> 32);
+#endif
+}
+
+// Returns a value uniformly distributed in [0, |range|), which must not be 0,
+// using |generator|, a callable returning uniformly distributed uint64_t
+// values. This is Lemire's multiply-shift method ("Fast Random Integer
+// Generation in an Interval", 2019): the common case takes one generator call
+// and one multiplication, and the rejection branch, which needs a division,
+// is taken with probability below |range| / 2^64.
+template <typename Generator>
+uint64_t RandGeneratorWith(uint64_t range, Generator&& generator) {
+  uint64_t low;
+  uint64_t high = MultiplyHigh64(generator(), range, &low);
+  if (low < range) {
+    const uint64_t threshold = (0 - range) % range;
+    while (low < threshold) {
+      high = MultiplyHigh64(generator(), range, &low);
+    }
+  }
+  return high;
+}
+
+}  // namespace internal
+
 uint64_t RandUint64();
 
 int RandInt(int min, int max);
@@ -24,6 +68,74 @@ double RandDouble();
 void RandBytes(span<uint8_t> output);
 std::string RandBytesAsString(size_t length);
 
+// A fast, non-cryptographic pseudo-random number generator (xoshiro256**).
+// Use it where randomness only needs to be statistically good, such as for
+// sampling, jitter and load balancing, and where the cost of the functions
+// above matters. Never use it for anything security-sensitive: its output is
+// predictable from a small number of previous outputs.
+//
+// A default-constructed generator is seeded from RandBytes(). An instance is
+// not thread-safe; use one per thread or per object.
+class InsecureRandomGenerator {
+ public:
+  InsecureRandomGenerator();
+
+  InsecureRandomGenerator(const InsecureRandomGenerator&) = delete;
+  InsecureRandomGenerator& operator=(const InsecureRandomGenerator&) = delete;
+
+  // Restarts the generator at a state derived from |seed|, so that tests can
+  // produce a reproducible sequence. Not enough entropy for anything else.
+  void ReseedForTesting(uint64_t seed);
+
+  uint32_t RandUint32() { return static_cast<uint32_t>(RandUint64() >> 32); }
+
+  uint64_t RandUint64() {
+    uint64_t result = RotateLeft(state_[1] * 5, 7) * 9;
+    uint64_t t = state_[1] << 17;
+    state_[2] ^= state_[0];
+    state_[3] ^= state_[1];
+    state_[1] ^= state_[2];
+    state_[0] ^= state_[3];
+    state_[2] ^= t;
+    state_[3] = RotateLeft(state_[3], 45);
+    return result;
+  }
+
+  // Returns a value uniformly distributed in [0, |range|).
+  uint64_t RandGenerator(uint64_t range) {
+    return internal::RandGeneratorWith(range, *this);
+  }
+
+  // Returns a value uniformly distributed in [|min|, |max|].
+  int RandInt(int min, int max);
+
+  // Returns a value uniformly distributed in [0, 1).
+  double RandDouble() { return ToDouble(RandUint64()); }
+
+  // Fill |output| with uniformly distributed values. For large outputs these
+  // run several independent streams, seeded from this one, in lockstep, which
+  // the compiler can vectorize. The values are therefore not the same as
+  // those that repeated RandUint64() or RandDouble() calls would produce, but
+  // they are equally reproducible after ReseedForTesting().
+  void Fill(span<uint64_t> output);
+  void Fill(span<double> output);
+
+  // Allows use as a generator callable, such as with RandGeneratorWith().
+  uint64_t operator()() { return RandUint64(); }
+
+ private:
+  static uint64_t RotateLeft(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+  }
+
+  static double ToDouble(uint64_t value) {
+    // The top 53 bits, scaled by 2^-53.
+    return static_cast<double>(value >> 11) * 0x1.0p-53;
+  }
+
+  uint64_t state_[4];
+};
+
 }  // namespace base
 
 #endif  // MINI_CHROMIUM_BASE_RAND_UTIL_H_
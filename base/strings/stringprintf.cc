@@ -11,6 +11,7 @@
 #include "base/logging.h"
 #include "base/scoped_clear_last_error.h"
 #include "base/strings/string_util.h"
+#include "base/threading/thread_local_cache.h"
 #include "build/build_config.h"
 
 namespace base {
@@ -24,6 +25,16 @@ inline int vsnprintfT(char* buffer,
   return base::vsnprintf(buffer, buf_size, format, argptr);
 }
 
+// Heap buffers used for output that does not fit on the stack are cached per
+// thread, unless they grew beyond this size.
+constexpr size_t kMaxCachedBufferSize = 64 * 1024;
+
+template <typename CharType>
+ThreadLocalCache<std::vector<CharType>>& FormatBufferCache() {
+  static auto* cache = new ThreadLocalCache<std::vector<CharType>>();
+  return *cache;
+}
+
 template <class StringType>
 static void StringAppendVT(StringType* dst,
                            const typename StringType::value_type* format,
@@ -73,17 +84,26 @@ static void StringAppendVT(StringType* dst,
       return;
     }
 
-    std::vector<typename StringType::value_type> mem_buf(mem_length);
+    using CharType = typename StringType::value_type;
+    typename ThreadLocalCache<std::vector<CharType>>::ScopedObject mem_buf(
+        FormatBufferCache<CharType>());
+    mem_buf->resize(mem_length);
 
     // NOTE: You can only use a va_list once.  Since we're in a while loop, we
     // need to make a new copy each time so we don't use up the original.
     va_copy(ap_copy, ap);
-    result = vsnprintfT(&mem_buf[0], mem_length, format, ap_copy);
+    result = vsnprintfT(mem_buf->data(), mem_length, format, ap_copy);
     va_end(ap_copy);
 
-    if ((result >= 0) && static_cast<unsigned int>(result) < mem_length) {
-      // It fit.
-      dst->append(&mem_buf[0], result);
+    bool fit = (result >= 0) && static_cast<unsigned int>(result) < mem_length;
+    if (fit) {
+      dst->append(mem_buf->data(), result);
+    }
+    if (mem_buf->capacity() > kMaxCachedBufferSize) {
+      // Don't keep an unusually large buffer alive in the cache.
+      std::vector<CharType>().swap(*mem_buf);
+    }
+    if (fit) {
       return;
     }
   }
@@ -12,6 +12,10 @@
 #include "base/strings/utf_string_conversion_utils.h"
 #include "build/build_config.h"
 
+#if defined(WCHAR_T_IS_16_BIT)
+#include "base/threading/thread_local_cache.h"
+#endif
+
 namespace {
 
 template<typename SRC_CHAR, typename DEST_STRING>
@@ -33,6 +37,12 @@ bool ConvertUnicode(const SRC_CHAR* src,
   return success;
 }
 
+#if defined(WCHAR_T_IS_16_BIT)
+// The scratch strings used by UTF8ToWide() are cached per thread, unless they
+// grew beyond this size.
+constexpr size_t kMaxCachedBufferSize = 64 * 1024;
+#endif
+
 }  // namespace
 
 namespace base {
@@ -68,9 +78,17 @@ std::string WideToUTF8(std::wstring_view wide) {
 }
 
 std::wstring UTF8ToWide(StringPiece utf8) {
-  std::u16string utf16 = UTF8ToUTF16(utf8);
-  return std::wstring(reinterpret_cast<const wchar_t*>(utf16.data()),
-                      utf16.size());
+  // The intermediate UTF-16 string is scratch space, so reuse one per thread.
+  static auto* utf16_cache = new ThreadLocalCache<std::u16string>();
+  ThreadLocalCache<std::u16string>::ScopedObject utf16(*utf16_cache);
+  UTF8ToUTF16(utf8.data(), utf8.length(), utf16.get());
+  std::wstring ret(reinterpret_cast<const wchar_t*>(utf16->data()),
+                   utf16->size());
+  if (utf16->capacity() > kMaxCachedBufferSize) {
+    // Don't keep an unusually large string alive in the cache.
+    std::u16string().swap(*utf16);
+  }
+  return ret;
 }
 #endif  // defined(WCHAR_T_IS_16_BIT)
 
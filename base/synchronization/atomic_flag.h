@@ -0,0 +1,41 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MINI_CHROMIUM_BASE_SYNCHRONIZATION_ATOMIC_FLAG_H_
+#define MINI_CHROMIUM_BASE_SYNCHRONIZATION_ATOMIC_FLAG_H_
+
+#include <stdint.h>
+
+#include <atomic>
+
+namespace base {
+
+// A flag that can safely be set from one thread and read from other threads.
+// Setting the flag is a release operation and reading it is an acquire
+// operation, so memory written before Set() is visible to a thread that has
+// observed IsSet() return true.
+class AtomicFlag {
+ public:
+  constexpr AtomicFlag() = default;
+
+  AtomicFlag(const AtomicFlag&) = delete;
+  AtomicFlag& operator=(const AtomicFlag&) = delete;
+
+  // Set the flag. Once set, the flag cannot be unset (except in tests).
+  void Set() { flag_.store(1, std::memory_order_release); }
+
+  // Returns true iff the flag was set.
+  bool IsSet() const { return flag_.load(std::memory_order_acquire) != 0; }
+
+  // Resets the flag. Be careful when using this: callers might not expect
+  // IsSet() to return false after returning true once.
+  void UnsafeResetForTesting() { flag_.store(0, std::memory_order_release); }
+
+ private:
+  std::atomic<uint_fast8_t> flag_{0};
+};
+
+}  // namespace base
+
+#endif  // MINI_CHROMIUM_BASE_SYNCHRONIZATION_ATOMIC_FLAG_H_
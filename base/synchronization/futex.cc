@@ -0,0 +1,142 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/synchronization/futex.h"
+
+#include "build/build_config.h"
+
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_ANDROID)
+#include <limits.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif BUILDFLAG(IS_WIN)
+#include <windows.h>
+#elif BUILDFLAG(IS_FUCHSIA)
+#include <zircon/syscalls.h>
+#else
+#include <stddef.h>
+
+#include <array>
+
+#include "base/synchronization/condition_variable.h"
+#include "base/synchronization/lock.h"
+#endif
+
+namespace base::internal {
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) &&
+                  std::atomic<uint32_t>::is_always_lock_free,
+              "The kernel must be able to read an atomic word in place");
+
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_ANDROID)
+
+namespace {
+
+uint32_t* FutexAddress(std::atomic<uint32_t>* word) {
+  return reinterpret_cast<uint32_t*>(word);
+}
+
+}  // namespace
+
+void FutexWait(std::atomic<uint32_t>* word, uint32_t expected) {
+  // EAGAIN (the value changed) and EINTR are both spurious wake-ups to the
+  // caller.
+  syscall(SYS_futex, FutexAddress(word), FUTEX_WAIT_PRIVATE, expected,
+          nullptr, nullptr, 0);
+}
+
+void FutexWakeOne(std::atomic<uint32_t>* word) {
+  syscall(SYS_futex, FutexAddress(word), FUTEX_WAKE_PRIVATE, 1, nullptr,
+          nullptr, 0);
+}
+
+void FutexWakeAll(std::atomic<uint32_t>* word) {
+  syscall(SYS_futex, FutexAddress(word), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr,
+          nullptr, 0);
+}
+
+#elif BUILDFLAG(IS_WIN)
+
+void FutexWait(std::atomic<uint32_t>* word, uint32_t expected) {
+  WaitOnAddress(word, &expected, sizeof(expected), INFINITE);
+}
+
+void FutexWakeOne(std::atomic<uint32_t>* word) {
+  WakeByAddressSingle(word);
+}
+
+void FutexWakeAll(std::atomic<uint32_t>* word) {
+  WakeByAddressAll(word);
+}
+
+#elif BUILDFLAG(IS_FUCHSIA)
+
+namespace {
+
+const zx_futex_t* FutexAddress(std::atomic<uint32_t>* word) {
+  return reinterpret_cast<const zx_futex_t*>(word);
+}
+
+}  // namespace
+
+void FutexWait(std::atomic<uint32_t>* word, uint32_t expected) {
+  zx_futex_wait(FutexAddress(word), static_cast<zx_futex_t>(expected),
+                ZX_HANDLE_INVALID, ZX_TIME_INFINITE);
+}
+
+void FutexWakeOne(std::atomic<uint32_t>* word) {
+  zx_futex_wake(FutexAddress(word), 1);
+}
+
+void FutexWakeAll(std::atomic<uint32_t>* word) {
+  zx_futex_wake(FutexAddress(word), UINT32_MAX);
+}
+
+#else
+
+// Without a futex, each word hashes to one of a fixed set of buckets, each a
+// lock and a condition variable. Waiters check the word under the bucket's
+// lock, and wakers take the lock before signalling, so a wake-up cannot fall
+// between a waiter's check and its sleep. Unrelated words can share a
+// bucket, so every wake-up is a broadcast.
+
+namespace {
+
+struct Bucket {
+  Lock lock;
+  ConditionVariable condition{&lock};
+};
+
+constexpr size_t kBucketCount = 64;
+
+Bucket& BucketFor(std::atomic<uint32_t>* word) {
+  static auto* buckets = new std::array<Bucket, kBucketCount>();
+  uintptr_t address = reinterpret_cast<uintptr_t>(word);
+  return (*buckets)[(address >> 2) % kBucketCount];
+}
+
+}  // namespace
+
+void FutexWait(std::atomic<uint32_t>* word, uint32_t expected) {
+  Bucket& bucket = BucketFor(word);
+  AutoLock lock(bucket.lock);
+  if (word->load(std::memory_order_relaxed) == expected) {
+    bucket.condition.Wait();
+  }
+}
+
+void FutexWakeOne(std::atomic<uint32_t>* word) {
+  FutexWakeAll(word);
+}
+
+void FutexWakeAll(std::atomic<uint32_t>* word) {
+  Bucket& bucket = BucketFor(word);
+  AutoLock lock(bucket.lock);
+  bucket.condition.Broadcast();
+}
+
+#endif
+
+}  // namespace base::internal
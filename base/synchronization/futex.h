@@ -0,0 +1,102 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MINI_CHROMIUM_BASE_SYNCHRONIZATION_FUTEX_H_
+#define MINI_CHROMIUM_BASE_SYNCHRONIZATION_FUTEX_H_
+
+#include <stdint.h>
+
+#include <atomic>
+
+namespace base {
+
+namespace internal {
+
+// Sleeps until woken by FutexWakeOne() or FutexWakeAll() on `word`, unless
+// `*word` no longer equals `expected`, which is checked atomically with going
+// to sleep. May also return spuriously, so callers must recheck whatever
+// condition they are waiting for.
+//
+// This is a futex on Linux and Android, WaitOnAddress() on Windows and a
+// Zircon futex on Fuchsia. Elsewhere it is emulated with a small table of
+// condition variables.
+void FutexWait(std::atomic<uint32_t>* word, uint32_t expected);
+
+// Wakes at least one, or all, of the threads sleeping in FutexWait() on
+// `word`.
+void FutexWakeOne(std::atomic<uint32_t>* word);
+void FutexWakeAll(std::atomic<uint32_t>* word);
+
+// Lets threads sleep until a condition, which other threads make true with
+// atomic operations rather than under a lock, might have become true. The
+// thread making it true calls Notify() afterwards, which wakes every waiting
+// thread. Notify() costs a fence and a load when no thread is waiting, or
+// when the waiting threads have already been woken but have not run yet, and
+// a wake-up system call otherwise.
+//
+//   // Consumer:
+//   not_empty_.Wait([&] { return tail_.load(std::memory_order_acquire) !=
+//                                head; });
+//
+//   // Producer:
+//   tail_.store(tail + 1, std::memory_order_release);
+//   not_empty_.Notify();
+class EventCount {
+ public:
+  constexpr EventCount() = default;
+
+  EventCount(const EventCount&) = delete;
+  EventCount& operator=(const EventCount&) = delete;
+
+  // Returns once `ready()` returns true, sleeping in between checks.
+  // `ready()` is not called again after it returns true, so it may claim
+  // what it finds, such as a slot in a queue.
+  template <typename Predicate>
+  void Wait(Predicate ready) {
+    while (!ready()) {
+      uint32_t epoch = epoch_.load(std::memory_order_acquire);
+      waiters_.fetch_add(1, std::memory_order_relaxed);
+      woken_.store(false, std::memory_order_relaxed);
+      // Pairs with the fence in Notify(): either this thread sees the
+      // notifier's change in `ready()`, or the notifier sees `waiters_` and
+      // `woken_` and wakes it.
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      bool done = ready();
+      if (!done) {
+        FutexWait(&epoch_, epoch);
+      }
+      waiters_.fetch_sub(1, std::memory_order_relaxed);
+      if (done) {
+        return;
+      }
+    }
+  }
+
+  void Notify() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters_.load(std::memory_order_relaxed) == 0) [[likely]] {
+      return;
+    }
+    // Only the first notifier since a thread started waiting needs to wake
+    // anyone; until a thread waits again, the others would only repeat it.
+    if (woken_.exchange(true, std::memory_order_acq_rel)) {
+      return;
+    }
+    // A waiter that read the old epoch but has not yet gone to sleep will
+    // not sleep, since the epoch no longer matches.
+    epoch_.fetch_add(1, std::memory_order_release);
+    FutexWakeAll(&epoch_);
+  }
+
+ private:
+  std::atomic<uint32_t> epoch_{0};
+  std::atomic<uint32_t> waiters_{0};
+  std::atomic<bool> woken_{false};
+};
+
+}  // namespace internal
+
+}  // namespace base
+
+#endif  // MINI_CHROMIUM_BASE_SYNCHRONIZATION_FUTEX_H_
@@ -0,0 +1,296 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MINI_CHROMIUM_BASE_SYNCHRONIZATION_MPMC_QUEUE_H_
+#define MINI_CHROMIUM_BASE_SYNCHRONIZATION_MPMC_QUEUE_H_
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <new>
+#include <optional>
+#include <utility>
+
+#include "base/compiler_specific.h"
+#include "base/containers/heap_array.h"
+#include "base/containers/span.h"
+#include "base/memory/cache_line_padded.h"
+#include "base/synchronization/futex.h"
+
+namespace base {
+
+// MPMCQueue<T> is a bounded, lock-free queue that any number of threads may
+// push to and pop from concurrently, such as a work queue feeding a pool of
+// threads. Values pushed by one thread are popped in the order they were
+// pushed, though values pushed by different threads may interleave.
+//
+// It is a ring of slots, each with a sequence number that says which lap of
+// the ring the slot is ready for and whether it holds a value (Dmitry
+// Vyukov's bounded MPMC queue). A push claims the next position with one
+// compare-and-swap on the producers' shared position and then fills the slot
+// without further contention, and a pop does the same on the consumers'
+// side. The two positions live on separate cache lines. A batch claims a run
+// of consecutive positions with a single compare-and-swap.
+//
+// The Try*() methods never block. Push() and Pop() sleep on a futex while the
+// queue is full or empty; they do not spin or take a lock. Every push and pop
+// checks whether any thread is sleeping, which costs a memory fence, so the
+// batch methods, which do it once per batch, are faster for streams of small
+// values.
+//
+//   base::MPMCQueue<std::unique_ptr<Job>> jobs(1024);
+//
+//   // Any number of producers:
+//   jobs.Push(std::make_unique<Job>(...));
+//
+//   // Any number of workers:
+//   while (std::unique_ptr<Job> job = jobs.Pop()) {
+//     job->Run();
+//   }
+//
+// The capacity is rounded up to a power of two, and is at least 2. To stop
+// consumers that are blocked in Pop(), push one value per consumer that tells
+// it to stop, such as the null job above.
+template <typename T>
+class MPMCQueue {
+ public:
+  explicit MPMCQueue(size_t capacity)
+      : mask_(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1),
+        cells_(HeapArray<Cell>::WithSize(mask_ + 1)) {
+    for (size_t i = 0; i < cells_.size(); ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MPMCQueue(const MPMCQueue&) = delete;
+  MPMCQueue& operator=(const MPMCQueue&) = delete;
+
+  ~MPMCQueue() {
+    size_t tail = tail_.load(std::memory_order_acquire);
+    for (size_t head = head_.load(std::memory_order_relaxed); head != tail;
+         ++head) {
+      std::destroy_at(ValueAt(head));
+    }
+  }
+
+  size_t capacity() const { return mask_ + 1; }
+
+  // Constructs a value at the back of the queue and returns true, or returns
+  // false if the queue is full. The arguments are only used on success.
+  template <typename... Args>
+  [[nodiscard]] bool TryEmplace(Args&&... args) {
+    size_t position;
+    if (ClaimForPush(1, &position) == 0) {
+      return false;
+    }
+    PublishValue(position, std::forward<Args>(args)...);
+    not_empty_.Notify();
+    return true;
+  }
+  [[nodiscard]] bool TryPush(const T& value) { return TryEmplace(value); }
+  [[nodiscard]] bool TryPush(T&& value) { return TryEmplace(std::move(value)); }
+
+  // Moves as many of `values` as fit to the back of the queue, in order, and
+  // returns how many that was. Other threads' values are not interleaved
+  // with them.
+  size_t TryPushBatch(span<T> values) {
+    size_t position;
+    size_t count = ClaimForPush(values.size(), &position);
+    PublishBatch(position, values.first(count));
+    return count;
+  }
+
+  // Like TryEmplace() and TryPushBatch(), but wait for space. PushBatch()
+  // pushes all of `values`, in order, but other threads' values may be
+  // interleaved with them if they do not all fit at once.
+  template <typename... Args>
+  void Emplace(Args&&... args) {
+    size_t position;
+    not_full_.Wait([&] { return ClaimForPush(1, &position) != 0; });
+    PublishValue(position, std::forward<Args>(args)...);
+    not_empty_.Notify();
+  }
+  void Push(const T& value) { Emplace(value); }
+  void Push(T&& value) { Emplace(std::move(value)); }
+  void PushBatch(span<T> values) {
+    while (!values.empty()) {
+      size_t position;
+      size_t count;
+      not_full_.Wait([&] {
+        count = ClaimForPush(values.size(), &position);
+        return count != 0;
+      });
+      PublishBatch(position, values.first(count));
+      values = values.subspan(count);
+    }
+  }
+
+  // Removes and returns the value at the front of the queue, or returns
+  // nullopt if the queue is empty.
+  std::optional<T> TryPop() {
+    size_t position;
+    if (ClaimForPop(1, &position) == 0) {
+      return std::nullopt;
+    }
+    return TakeValue(position);
+  }
+
+  // Moves up to `out.size()` values from the front of the queue to the start
+  // of `out`, and returns how many that was. They are consecutive values in
+  // the queue.
+  size_t TryPopBatch(span<T> out) {
+    size_t position;
+    size_t count = ClaimForPop(out.size(), &position);
+    TakeBatch(position, out.first(count));
+    return count;
+  }
+
+  // Like TryPop() and TryPopBatch(), but wait for a value. PopBatch() returns
+  // as soon as it has at least one value, unless `out` is empty.
+  T Pop() {
+    size_t position;
+    not_empty_.Wait([&] { return ClaimForPop(1, &position) != 0; });
+    return TakeValue(position);
+  }
+  size_t PopBatch(span<T> out) {
+    if (out.empty()) {
+      return 0;
+    }
+    size_t position;
+    size_t count;
+    not_empty_.Wait([&] {
+      count = ClaimForPop(out.size(), &position);
+      return count != 0;
+    });
+    TakeBatch(position, out.first(count));
+    return count;
+  }
+
+ private:
+  // A slot. Its sequence number is p when it is free for a push at position
+  // p, and p + 1 once that push has stored its value there. The pop at
+  // position p then sets it to p + capacity(), for the next lap.
+  struct Cell {
+    std::atomic<size_t> sequence;
+    alignas(T) unsigned char bytes[sizeof(T)];
+  };
+
+  Cell& CellAt(size_t position) {
+    // SAFETY: The masked position is less than cells_.size().
+    return UNSAFE_BUFFERS(cells_.data()[position & mask_]);
+  }
+
+  T* ValueAt(size_t position) {
+    return std::launder(reinterpret_cast<T*>(CellAt(position).bytes));
+  }
+
+  // Claims up to `wanted` consecutive free positions, sets `*first` to the
+  // first of them and returns how many there are, or returns 0 if the queue
+  // is full. Positions whose cells are free can only be taken by a push, so
+  // those counted before the compare-and-swap are still free after it.
+  size_t ClaimForPush(size_t wanted, size_t* first) {
+    return Claim(tail_, 0, wanted, first);
+  }
+
+  // Like ClaimForPush(), but claims positions holding values.
+  size_t ClaimForPop(size_t wanted, size_t* first) {
+    return Claim(head_, 1, wanted, first);
+  }
+
+  // Claims positions from `next` whose sequence number is the position plus
+  // `offset`.
+  size_t Claim(std::atomic<size_t>& next,
+               size_t offset,
+               size_t wanted,
+               size_t* first) {
+    if (wanted == 0) {
+      return 0;
+    }
+    size_t position = next.load(std::memory_order_relaxed);
+    for (;;) {
+      size_t sequence =
+          CellAt(position).sequence.load(std::memory_order_acquire);
+      ptrdiff_t lag = static_cast<ptrdiff_t>(sequence - (position + offset));
+      if (lag < 0) {
+        // The cell is still a lap behind: the queue is full (or empty).
+        return 0;
+      }
+      if (lag > 0) {
+        // Another thread claimed the position.
+        position = next.load(std::memory_order_relaxed);
+        continue;
+      }
+      size_t count = 1;
+      while (count < wanted &&
+             CellAt(position + count).sequence.load(
+                 std::memory_order_acquire) == position + count + offset) {
+        ++count;
+      }
+      if (next.compare_exchange_weak(position, position + count,
+                                     std::memory_order_relaxed)) {
+        *first = position;
+        return count;
+      }
+    }
+  }
+
+  template <typename... Args>
+  void PublishValue(size_t position, Args&&... args) {
+    new (ValueAt(position)) T(std::forward<Args>(args)...);
+    CellAt(position).sequence.store(position + 1, std::memory_order_release);
+  }
+
+  void PublishBatch(size_t position, span<T> values) {
+    if (values.empty()) {
+      return;
+    }
+    for (size_t i = 0; i < values.size(); ++i) {
+      PublishValue(position + i, std::move(values[i]));
+    }
+    not_empty_.Notify();
+  }
+
+  void ReleaseCell(size_t position) {
+    std::destroy_at(ValueAt(position));
+    CellAt(position).sequence.store(position + capacity(),
+                                    std::memory_order_release);
+  }
+
+  T TakeValue(size_t position) {
+    T result = std::move(*ValueAt(position));
+    ReleaseCell(position);
+    not_full_.Notify();
+    return result;
+  }
+
+  void TakeBatch(size_t position, span<T> out) {
+    if (out.empty()) {
+      return;
+    }
+    for (size_t i = 0; i < out.size(); ++i) {
+      out[i] = std::move(*ValueAt(position + i));
+      ReleaseCell(position + i);
+    }
+    not_full_.Notify();
+  }
+
+  // Positions count up forever; a position's cell is position & mask_.
+  const size_t mask_;
+  HeapArray<Cell> cells_;
+
+  // The next positions to push to and pop from.
+  alignas(kCacheLineSize) std::atomic<size_t> tail_{0};
+  alignas(kCacheLineSize) std::atomic<size_t> head_{0};
+
+  // Waited on by consumers and producers respectively.
+  alignas(kCacheLineSize) internal::EventCount not_empty_;
+  alignas(kCacheLineSize) internal::EventCount not_full_;
+};
+
+}  // namespace base
+
+#endif  // MINI_CHROMIUM_BASE_SYNCHRONIZATION_MPMC_QUEUE_H_
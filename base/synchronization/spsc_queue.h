@@ -0,0 +1,232 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MINI_CHROMIUM_BASE_SYNCHRONIZATION_SPSC_QUEUE_H_
+#define MINI_CHROMIUM_BASE_SYNCHRONIZATION_SPSC_QUEUE_H_
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <new>
+#include <optional>
+#include <utility>
+
+#include "base/compiler_specific.h"
+#include "base/containers/heap_array.h"
+#include "base/containers/span.h"
+#include "base/memory/cache_line_padded.h"
+#include "base/synchronization/futex.h"
+
+namespace base {
+
+// SPSCQueue<T> is a bounded, lock-free queue for handing values from exactly
+// one producer thread to exactly one consumer thread, such as between two
+// stages of a pipeline. Any number of threads may use the queue over its
+// lifetime, but at most one may push and one may pop at a time.
+//
+// The producer's and the consumer's positions live on separate cache lines,
+// and each side keeps a cached copy of the other's position, which it only
+// rereads when the queue looks full (or empty). So in the steady state, a
+// push or pop touches no cache line that the other thread writes, apart from
+// the slot itself.
+//
+// The Try*() methods never block. Push() and Pop() sleep on a futex while the
+// queue is full or empty; they do not spin or take a lock. Every push and pop
+// checks whether the other side is sleeping, which costs a memory fence, so
+// the batch methods, which do it once per batch, are considerably faster for
+// streams of small values:
+//
+//   // Producer:
+//   std::vector<Record> records = Parse(chunk);
+//   queue.PushBatch(records);
+//
+//   // Consumer:
+//   std::array<Record, 64> records;
+//   for (Record& record : span(records).first(queue.PopBatch(records))) {
+//     Process(record);
+//   }
+//
+// The capacity is rounded up to a power of two. To stop a consumer that is
+// blocked in Pop(), push a value that tells it to stop.
+template <typename T>
+class SPSCQueue {
+ public:
+  explicit SPSCQueue(size_t capacity)
+      : mask_(std::bit_ceil(std::max<size_t>(capacity, 1)) - 1),
+        slots_(HeapArray<Slot>::Uninit(mask_ + 1)) {}
+
+  SPSCQueue(const SPSCQueue&) = delete;
+  SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+  ~SPSCQueue() {
+    size_t tail = tail_.load(std::memory_order_acquire);
+    for (size_t head = head_.load(std::memory_order_relaxed); head != tail;
+         ++head) {
+      std::destroy_at(At(head));
+    }
+  }
+
+  size_t capacity() const { return mask_ + 1; }
+
+  // Producer methods.
+
+  // Constructs a value at the back of the queue and returns true, or returns
+  // false if the queue is full. The arguments are only used on success.
+  template <typename... Args>
+  [[nodiscard]] bool TryEmplace(Args&&... args) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    if (FreeSlots(tail) == 0) {
+      return false;
+    }
+    new (At(tail)) T(std::forward<Args>(args)...);
+    tail_.store(tail + 1, std::memory_order_release);
+    not_empty_.Notify();
+    return true;
+  }
+  [[nodiscard]] bool TryPush(const T& value) { return TryEmplace(value); }
+  [[nodiscard]] bool TryPush(T&& value) { return TryEmplace(std::move(value)); }
+
+  // Moves as many of `values` as fit to the back of the queue, in order, and
+  // returns how many that was.
+  size_t TryPushBatch(span<T> values) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    size_t count = std::min(values.size(), FreeSlots(tail, values.size()));
+    if (count == 0) {
+      return 0;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      new (At(tail + i)) T(std::move(values[i]));
+    }
+    tail_.store(tail + count, std::memory_order_release);
+    not_empty_.Notify();
+    return count;
+  }
+
+  // Like TryEmplace() and TryPushBatch(), but wait for space.
+  template <typename... Args>
+  void Emplace(Args&&... args) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    not_full_.Wait([&] { return FreeSlots(tail) != 0; });
+    new (At(tail)) T(std::forward<Args>(args)...);
+    tail_.store(tail + 1, std::memory_order_release);
+    not_empty_.Notify();
+  }
+  void Push(const T& value) { Emplace(value); }
+  void Push(T&& value) { Emplace(std::move(value)); }
+  void PushBatch(span<T> values) {
+    while (!values.empty()) {
+      size_t tail = tail_.load(std::memory_order_relaxed);
+      not_full_.Wait([&] { return FreeSlots(tail) != 0; });
+      values = values.subspan(TryPushBatch(values));
+    }
+  }
+
+  // Consumer methods.
+
+  // Removes and returns the value at the front of the queue, or returns
+  // nullopt if the queue is empty.
+  std::optional<T> TryPop() {
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (FilledSlots(head) == 0) {
+      return std::nullopt;
+    }
+    return PopAt(head);
+  }
+
+  // Moves up to `out.size()` values from the front of the queue to the start
+  // of `out`, and returns how many that was.
+  size_t TryPopBatch(span<T> out) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    size_t count = std::min(out.size(), FilledSlots(head, out.size()));
+    if (count == 0) {
+      return 0;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      T* value = At(head + i);
+      out[i] = std::move(*value);
+      std::destroy_at(value);
+    }
+    head_.store(head + count, std::memory_order_release);
+    not_full_.Notify();
+    return count;
+  }
+
+  // Like TryPop() and TryPopBatch(), but wait for a value. PopBatch() returns
+  // as soon as it has at least one value, unless `out` is empty.
+  T Pop() {
+    size_t head = head_.load(std::memory_order_relaxed);
+    not_empty_.Wait([&] { return FilledSlots(head) != 0; });
+    return PopAt(head);
+  }
+  size_t PopBatch(span<T> out) {
+    if (out.empty()) {
+      return 0;
+    }
+    size_t head = head_.load(std::memory_order_relaxed);
+    not_empty_.Wait([&] { return FilledSlots(head) != 0; });
+    return TryPopBatch(out);
+  }
+
+ private:
+  struct Slot {
+    alignas(T) unsigned char bytes[sizeof(T)];
+  };
+
+  T* At(size_t position) {
+    // SAFETY: The masked position is less than slots_.size().
+    Slot& slot = UNSAFE_BUFFERS(slots_.data()[position & mask_]);
+    return std::launder(reinterpret_cast<T*>(slot.bytes));
+  }
+
+  // Producer only. Returns how many slots are free, rereading the consumer's
+  // position only if the cached one says there are fewer than `wanted`.
+  size_t FreeSlots(size_t tail, size_t wanted = 1) {
+    if (capacity() - (tail - cached_head_) < wanted) {
+      cached_head_ = head_.load(std::memory_order_acquire);
+    }
+    return capacity() - (tail - cached_head_);
+  }
+
+  // Consumer only. Returns how many slots hold values, rereading the
+  // producer's position only if the cached one says there are fewer than
+  // `wanted`.
+  size_t FilledSlots(size_t head, size_t wanted = 1) {
+    if (cached_tail_ - head < wanted) {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+    }
+    return cached_tail_ - head;
+  }
+
+  T PopAt(size_t head) {
+    T* value = At(head);
+    T result = std::move(*value);
+    std::destroy_at(value);
+    head_.store(head + 1, std::memory_order_release);
+    not_full_.Notify();
+    return result;
+  }
+
+  // Positions count up forever; a position's slot is position & mask_.
+  const size_t mask_;
+  HeapArray<Slot> slots_;
+
+  // Written by the producer.
+  alignas(kCacheLineSize) std::atomic<size_t> tail_{0};
+  size_t cached_head_ = 0;
+
+  // Written by the consumer.
+  alignas(kCacheLineSize) std::atomic<size_t> head_{0};
+  size_t cached_tail_ = 0;
+
+  // Waited on by the consumer and the producer respectively.
+  alignas(kCacheLineSize) internal::EventCount not_empty_;
+  internal::EventCount not_full_;
+};
+
+}  // namespace base
+
+#endif  // MINI_CHROMIUM_BASE_SYNCHRONIZATION_SPSC_QUEUE_H_
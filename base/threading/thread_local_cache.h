@@ -0,0 +1,172 @@
+// Copyright 2026 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MINI_CHROMIUM_BASE_THREADING_THREAD_LOCAL_CACHE_H_
+#define MINI_CHROMIUM_BASE_THREADING_THREAD_LOCAL_CACHE_H_
+
+#include <stddef.h>
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include "base/threading/thread_local_storage.h"
+
+namespace base {
+
+// ThreadLocalCache<T> keeps released T objects around for reuse so that hot
+// paths which need a scratch object (a format buffer, a conversion output, a
+// temporary array) do not allocate one on every call.
+//
+// Each thread keeps up to |kMaxPerThread| released objects of its own, which
+// are taken and returned without synchronization. When a thread's list is
+// full, released objects go to a central pool of up to |kCentralPoolSize|
+// objects shared by all threads; beyond that they are deleted. A thread whose
+// own list is empty takes from the central pool before constructing a new T.
+// When a thread exits, its list is moved to the central pool by a
+// ThreadLocalStorage destructor.
+//
+// Objects are handed out in whatever state they were returned in, so callers
+// are responsible for resetting them (e.g. clear() on a container, which
+// keeps its capacity). Callers should also avoid returning objects that have
+// grown unusually large, since the cache holds on to them indefinitely.
+//
+// A ThreadLocalCache should be a leaked function-local static:
+//
+//   ThreadLocalCache<std::string>& StringCache() {
+//     static auto* cache = new ThreadLocalCache<std::string>();
+//     return *cache;
+//   }
+//
+//   {
+//     ThreadLocalCache<std::string>::ScopedObject buffer(StringCache());
+//     buffer->clear();
+//     ...
+//   }  // |buffer| is released back to the cache here.
+//
+// If a ThreadLocalCache is destroyed, objects cached by threads other than the
+// destroying thread are leaked.
+template <typename T, size_t kMaxPerThread = 4, size_t kCentralPoolSize = 32>
+class ThreadLocalCache {
+ public:
+  // Takes an object from the cache on construction and releases it back to
+  // the cache on destruction.
+  class ScopedObject {
+   public:
+    explicit ScopedObject(ThreadLocalCache& cache)
+        : cache_(cache), object_(cache.Take()) {}
+
+    ScopedObject(const ScopedObject&) = delete;
+    ScopedObject& operator=(const ScopedObject&) = delete;
+
+    ~ScopedObject() { cache_.Release(std::move(object_)); }
+
+    T& operator*() const { return *object_; }
+    T* operator->() const { return object_.get(); }
+    T* get() const { return object_.get(); }
+
+   private:
+    ThreadLocalCache& cache_;
+    std::unique_ptr<T> object_;
+  };
+
+  ThreadLocalCache() : slot_(&OnThreadExit) {}
+
+  ThreadLocalCache(const ThreadLocalCache&) = delete;
+  ThreadLocalCache& operator=(const ThreadLocalCache&) = delete;
+
+  ~ThreadLocalCache() {
+    if (ThreadList* list = static_cast<ThreadList*>(slot_.Get())) {
+      while (list->count > 0) {
+        delete list->objects[--list->count];
+      }
+      delete list;
+      slot_.Set(nullptr);
+    }
+    for (std::atomic<T*>& entry : central_pool_) {
+      delete entry.exchange(nullptr, std::memory_order_acquire);
+    }
+  }
+
+  // Returns a cached object if one is available, and a new value-initialized
+  // T otherwise.
+  std::unique_ptr<T> Take() {
+    ThreadList* list = static_cast<ThreadList*>(slot_.Get());
+    if (list && list->count > 0) {
+      return std::unique_ptr<T>(list->objects[--list->count]);
+    }
+    if (T* object = TakeFromCentralPool()) {
+      return std::unique_ptr<T>(object);
+    }
+    return std::make_unique<T>();
+  }
+
+  // Gives |object| back to the cache for reuse.
+  void Release(std::unique_ptr<T> object) {
+    if (!object) {
+      return;
+    }
+    ThreadList* list = static_cast<ThreadList*>(slot_.Get());
+    if (!list) {
+      list = new ThreadList(this);
+      slot_.Set(list);
+    }
+    if (list->count < kMaxPerThread) {
+      list->objects[list->count++] = object.release();
+      return;
+    }
+    ReleaseToCentralPool(object.release());
+  }
+
+ private:
+  struct ThreadList {
+    explicit ThreadList(ThreadLocalCache* cache) : cache(cache) {}
+
+    ThreadLocalCache* const cache;
+    size_t count = 0;
+    T* objects[kMaxPerThread];
+  };
+
+  // The central pool is a fixed array of entries, each either null or owning
+  // one object. Objects are claimed with exchange() and deposited with
+  // compare_exchange() into an empty entry, so there is no ABA hazard.
+  T* TakeFromCentralPool() {
+    for (std::atomic<T*>& entry : central_pool_) {
+      if (entry.load(std::memory_order_relaxed)) {
+        if (T* object = entry.exchange(nullptr, std::memory_order_acquire)) {
+          return object;
+        }
+      }
+    }
+    return nullptr;
+  }
+
+  void ReleaseToCentralPool(T* object) {
+    for (std::atomic<T*>& entry : central_pool_) {
+      T* expected = nullptr;
+      if (!entry.load(std::memory_order_relaxed) &&
+          entry.compare_exchange_strong(expected, object,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed)) {
+        return;
+      }
+    }
+    delete object;
+  }
+
+  static void OnThreadExit(void* value) {
+    ThreadList* list = static_cast<ThreadList*>(value);
+    while (list->count > 0) {
+      list->cache->ReleaseToCentralPool(list->objects[--list->count]);
+    }
+    delete list;
+  }
+
+  ThreadLocalStorage::Slot slot_;
+  std::atomic<T*> central_pool_[kCentralPoolSize] = {};
+};
+
+}  // namespace base
+
+#endif  // MINI_CHROMIUM_BASE_THREADING_THREAD_LOCAL_CACHE_H_
@@ -4,54 +4,220 @@
 
 #include "base/threading/thread_local_storage.h"
 
+#include <stdint.h>
 #include <string.h>
 
+#include <atomic>
+#include <bit>
+
+#include "base/atomic_counter.h"
 #include "base/check_op.h"
 #include "base/notreached.h"
-#include "base/atomicops.h"
 
 using base::internal::PlatformThreadLocalStorage;
 
 namespace {
 
 // In order to make TLS destructors work, we need to keep around a function
-// pointer to the destructor for each slot. We keep this array of pointers in a
-// global (static) array.
+// pointer to the destructor for each slot. We keep this table of pointers in a
+// global (static) table.
 // We use the single OS-level TLS slot (giving us one pointer per thread) to
-// hold a pointer to a per-thread array (table) of slots that we allocate to
-// Chromium consumers.
+// hold a pointer to a per-thread table of slots that we allocate to Chromium
+// consumers. The same pointer is mirrored in a compiler thread_local so that
+// Get() and Set() can reach it without a call into the OS; the OS-level slot
+// remains the one that gets us called back at thread exit.
+//
+// Both tables are chunked so that they can grow without moving. Slots
+// [0, kInlineSlots) live inline in the table header. Beyond that, chunk c
+// (counting from 1) holds slots [kInlineSlots << (c - 1), kInlineSlots << c),
+// so each chunk doubles the capacity and a slot's chunk is found from the
+// position of its highest set bit. Chunks are allocated on first use.
 
 // g_native_tls_key is the one native TLS that we use.  It stores our table.
-base::subtle::Atomic32 g_native_tls_key =
-    PlatformThreadLocalStorage::TLS_KEY_OUT_OF_INDEXES;
+// It is only ever published once, and every reader tolerates seeing the
+// initial value, so all accesses are relaxed.
+std::atomic<PlatformThreadLocalStorage::TLSKey> g_native_tls_key{
+    PlatformThreadLocalStorage::TLS_KEY_OUT_OF_INDEXES};
 
 // g_last_used_tls_key is the high-water-mark of allocated thread local storage.
-// Each allocation is an index into our g_tls_destructors[].  Each such index is
+// Each allocation is an index into our slot info table.  Each such index is
 // assigned to the instance variable slot_ in a ThreadLocalStorage::Slot
 // instance.  We reserve the value slot_ == 0 to indicate that the corresponding
 // instance of ThreadLocalStorage::Slot has been freed (i.e., destructor called,
 // etc.).  This reserved use of 0 is then stated as the initial value of
 // g_last_used_tls_key, so that the first issued index will be 1.
-base::subtle::Atomic32 g_last_used_tls_key = 0;
+base::AtomicCounter<int> g_last_used_tls_key;
+
+// Freed slots are pushed onto a lock-free stack and reused by later
+// allocations before the high-water-mark is raised. The head packs a version
+// tag in the upper 32 bits above the top slot in the lower 32 bits (0 when the
+// stack is empty); the tag changes on every update so that a pop which raced
+// with a pop and re-push of the same slot fails its compare-exchange.
+std::atomic<uint64_t> g_free_slots_head{0};
 
-// The maximum number of 'slots' in our thread local storage stack.
-const int kThreadLocalStorageSize = 256;
+// The number of slots stored inline in each thread's table, and in the static
+// part of the destructor table. Slots allocated early in the life of the
+// process, such as those used by allocators, land here and never require a
+// chunk allocation.
+constexpr int kInlineSlotsLog2 = 5;
+constexpr int kInlineSlots = 1 << kInlineSlotsLog2;
+
+// Enough chunks to cover every positive int slot number.
+constexpr int kMaxChunks = 31 - kInlineSlotsLog2;
 
 // The maximum number of times to try to clear slots by calling destructors.
 // Use pthread naming convention for clarity.
-const int kMaxDestructorIterations = kThreadLocalStorageSize;
-
-// An array of destructor function pointers for the slots.  If a slot has a
-// destructor, it will be stored in its corresponding entry in this array.
-// The elements are volatile to ensure that when the compiler reads the value
-// to potentially call the destructor, it does so once, and that value is tested
-// for null-ness and then used. Yes, that would be a weird de-optimization,
-// but I can imagine some register machines where it was just as easy to
-// re-fetch an array element, and I want to be sure a call to free the key
-// (i.e., null out the destructor entry) that happens on a separate thread can't
-// hurt the racy calls to the destructors on another thread.
-volatile base::ThreadLocalStorage::TLSDestructorFunc
-    g_tls_destructors[kThreadLocalStorageSize];
+constexpr int kMaxDestructorIterations = 256;
+
+// Returns the chunk number (1-based) holding |slot|, which must not be inline,
+// and stores the slot's index within that chunk in |offset|.
+int ChunkForSlot(int slot, int* offset) {
+  int chunk = std::bit_width(static_cast<unsigned int>(slot)) -
+              kInlineSlotsLog2;
+  *offset = slot - (kInlineSlots << (chunk - 1));
+  return chunk;
+}
+
+int ChunkSize(int chunk) {
+  return kInlineSlots << (chunk - 1);
+}
+
+// The global state of one slot.
+struct SlotInfo {
+  // The slot's destructor, if it has one. This is atomic so that a call to
+  // free the key (i.e., null out the destructor) that happens on a separate
+  // thread can't hurt the racy calls to the destructors on another thread:
+  // it is read once, tested for null-ness, and then used.
+  std::atomic<base::ThreadLocalStorage::TLSDestructorFunc> destructor;
+
+  // Incremented each time the slot is freed, so that values stored by a
+  // previous owner of a reused slot can be recognized as stale.
+  std::atomic<uint32_t> generation;
+
+  // The next slot on the free stack, while this slot is on it.
+  std::atomic<int> next_free;
+};
+
+SlotInfo g_slot_info[kInlineSlots];
+std::atomic<SlotInfo*> g_slot_info_chunks[kMaxChunks];
+
+// Returns the info for |slot|, or nullptr if its chunk has never been
+// allocated (which means that the slot has never been allocated).
+SlotInfo* GetSlotInfo(int slot) {
+  if (slot < kInlineSlots)
+    return &g_slot_info[slot];
+  int offset;
+  int chunk = ChunkForSlot(slot, &offset);
+  SlotInfo* infos =
+      g_slot_info_chunks[chunk - 1].load(std::memory_order_acquire);
+  return infos ? &infos[offset] : nullptr;
+}
+
+// Returns the info for |slot|, allocating its chunk if needed.
+SlotInfo* EnsureSlotInfo(int slot) {
+  SlotInfo* info = GetSlotInfo(slot);
+  if (info)
+    return info;
+  int offset;
+  int chunk = ChunkForSlot(slot, &offset);
+  SlotInfo* infos = new SlotInfo[ChunkSize(chunk)]();
+  SlotInfo* expected = nullptr;
+  if (!g_slot_info_chunks[chunk - 1].compare_exchange_strong(
+          expected, infos, std::memory_order_acq_rel)) {
+    // Another thread installed this chunk first.
+    delete[] infos;
+    infos = expected;
+  }
+  return &infos[offset];
+}
+
+// Pops a previously freed slot, or returns 0 if there is none.
+int PopFreeSlot() {
+  uint64_t head = g_free_slots_head.load(std::memory_order_acquire);
+  while (true) {
+    int slot = static_cast<int>(head & 0xffffffff);
+    if (slot == 0)
+      return 0;
+    // The info for a slot on the stack is never freed, so this is safe to
+    // read even if another thread pops the slot first.
+    int next = GetSlotInfo(slot)->next_free.load(std::memory_order_relaxed);
+    uint64_t new_head =
+        ((head >> 32) + 1) << 32 | static_cast<uint32_t>(next);
+    if (g_free_slots_head.compare_exchange_weak(head, new_head,
+                                                std::memory_order_acquire)) {
+      return slot;
+    }
+  }
+}
+
+void PushFreeSlot(int slot) {
+  SlotInfo* info = GetSlotInfo(slot);
+  uint64_t head = g_free_slots_head.load(std::memory_order_relaxed);
+  while (true) {
+    info->next_free.store(static_cast<int>(head & 0xffffffff),
+                          std::memory_order_relaxed);
+    uint64_t new_head =
+        ((head >> 32) + 1) << 32 | static_cast<uint32_t>(slot);
+    if (g_free_slots_head.compare_exchange_weak(head, new_head,
+                                                std::memory_order_release)) {
+      return;
+    }
+  }
+}
+
+// A value stored in one thread's table, along with the generation of the slot
+// at the time it was stored. A value whose generation differs from that of the
+// slot's current owner belongs to a previous owner and reads as null.
+struct TlsEntry {
+  void* value;
+  uint32_t generation;
+};
+
+// The per-thread table of slot values.
+struct TlsVector {
+  TlsEntry inline_slots[kInlineSlots];
+  TlsEntry* chunks[kMaxChunks];
+};
+
+// The fast-path mirror of this thread's value for g_native_tls_key.
+constinit thread_local TlsVector* t_tls_vector = nullptr;
+
+void SetTlsVector(PlatformThreadLocalStorage::TLSKey key, TlsVector* vector) {
+  PlatformThreadLocalStorage::SetTLSValue(key, vector);
+  t_tls_vector = vector;
+}
+
+// Returns the entry for |slot| in |vector|, or nullptr if its chunk has not
+// been allocated, in which case the slot's value is null.
+TlsEntry* GetSlotEntry(TlsVector* vector, int slot) {
+  if (slot < kInlineSlots)
+    return &vector->inline_slots[slot];
+  int offset;
+  int chunk = ChunkForSlot(slot, &offset);
+  TlsEntry* values = vector->chunks[chunk - 1];
+  return values ? &values[offset] : nullptr;
+}
+
+// Returns the entry for |slot| in the current thread's table, allocating its
+// chunk if needed.
+TlsEntry* EnsureSlotEntry(int slot) {
+  TlsEntry* entry = GetSlotEntry(t_tls_vector, slot);
+  if (entry)
+    return entry;
+  int offset;
+  int chunk = ChunkForSlot(slot, &offset);
+  TlsEntry* values = new TlsEntry[ChunkSize(chunk)]();
+  // The allocator may have re-entered and populated this chunk itself, and
+  // the table may have moved from the stack to the heap in the meantime, so
+  // look everything up again.
+  TlsVector* vector = t_tls_vector;
+  if (vector->chunks[chunk - 1]) {
+    delete[] values;
+  } else {
+    vector->chunks[chunk - 1] = values;
+  }
+  return &vector->chunks[chunk - 1][offset];
+}
 
 // This function is called to initialize our entire Chromium TLS system.
 // It may be called very early, and we need to complete most all of the setup
@@ -59,14 +225,14 @@ volatile base::ThreadLocalStorage::TLSDestructorFunc
 // recursively depend on this initialization.
 // As a result, we use Atomics, and avoid anything (like a singleton) that might
 // require memory allocations.
-void** ConstructTlsVector() {
+TlsVector* ConstructTlsVector() {
   PlatformThreadLocalStorage::TLSKey key =
-      base::subtle::NoBarrier_Load(&g_native_tls_key);
+      g_native_tls_key.load(std::memory_order_relaxed);
   if (key == PlatformThreadLocalStorage::TLS_KEY_OUT_OF_INDEXES) {
     CHECK(PlatformThreadLocalStorage::AllocTLS(&key));
 
     // The TLS_KEY_OUT_OF_INDEXES is used to find out whether the key is set or
-    // not in NoBarrier_CompareAndSwap, but Posix doesn't have invalid key, we
+    // not in the compare-exchange below, but Posix doesn't have invalid key, we
     // define an almost impossible value be it.
     // If we really get TLS_KEY_OUT_OF_INDEXES as value of key, just alloc
     // another TLS slot.
@@ -79,15 +245,15 @@ void** ConstructTlsVector() {
     // Atomically test-and-set the tls_key.  If the key is
     // TLS_KEY_OUT_OF_INDEXES, go ahead and set it.  Otherwise, do nothing, as
     // another thread already did our dirty work.
-    if (PlatformThreadLocalStorage::TLS_KEY_OUT_OF_INDEXES !=
-        base::subtle::NoBarrier_CompareAndSwap(&g_native_tls_key,
-            PlatformThreadLocalStorage::TLS_KEY_OUT_OF_INDEXES,
-            static_cast<base::subtle::Atomic32>(key))) {
+    PlatformThreadLocalStorage::TLSKey expected =
+        PlatformThreadLocalStorage::TLS_KEY_OUT_OF_INDEXES;
+    if (!g_native_tls_key.compare_exchange_strong(
+            expected, key, std::memory_order_relaxed)) {
       // We've been shortcut. Another thread replaced g_native_tls_key first so
       // we need to destroy our index and use the one the other thread got
       // first.
       PlatformThreadLocalStorage::FreeTLS(key);
-      key = base::subtle::NoBarrier_Load(&g_native_tls_key);
+      key = expected;
     }
   }
   CHECK(!PlatformThreadLocalStorage::GetTLSValue(key));
@@ -100,39 +266,24 @@ void** ConstructTlsVector() {
   // Use a stack allocated vector, so that we don't have dependence on our
   // allocator until our service is in place.  (i.e., don't even call new until
   // after we're setup)
-  void* stack_allocated_tls_data[kThreadLocalStorageSize];
-  memset(stack_allocated_tls_data, 0, sizeof(stack_allocated_tls_data));
+  TlsVector stack_allocated_tls_data;
+  memset(&stack_allocated_tls_data, 0, sizeof(stack_allocated_tls_data));
   // Ensure that any rentrant calls change the temp version.
-  PlatformThreadLocalStorage::SetTLSValue(key, stack_allocated_tls_data);
+  SetTlsVector(key, &stack_allocated_tls_data);
 
   // Allocate an array to store our data.
-  void** tls_data = new void*[kThreadLocalStorageSize];
-  memcpy(tls_data, stack_allocated_tls_data, sizeof(stack_allocated_tls_data));
-  PlatformThreadLocalStorage::SetTLSValue(key, tls_data);
+  TlsVector* tls_data = new TlsVector;
+  memcpy(tls_data, &stack_allocated_tls_data, sizeof(stack_allocated_tls_data));
+  SetTlsVector(key, tls_data);
   return tls_data;
 }
 
-void OnThreadExitInternal(void* value) {
-  DCHECK(value);
-  void** tls_data = static_cast<void**>(value);
-  // Some allocators, such as TCMalloc, use TLS.  As a result, when a thread
-  // terminates, one of the destructor calls we make may be to shut down an
-  // allocator.  We have to be careful that after we've shutdown all of the
-  // known destructors (perchance including an allocator), that we don't call
-  // the allocator and cause it to resurrect itself (with no possibly destructor
-  // call to follow).  We handle this problem as follows:
-  // Switch to using a stack allocated vector, so that we don't have dependence
-  // on our allocator after we have called all g_tls_destructors.  (i.e., don't
-  // even call delete[] after we're done with destructors.)
-  void* stack_allocated_tls_data[kThreadLocalStorageSize];
-  memcpy(stack_allocated_tls_data, tls_data, sizeof(stack_allocated_tls_data));
-  // Ensure that any re-entrant calls change the temp version.
-  PlatformThreadLocalStorage::TLSKey key =
-      base::subtle::NoBarrier_Load(&g_native_tls_key);
-  PlatformThreadLocalStorage::SetTLSValue(key, stack_allocated_tls_data);
-  delete[] tls_data;  // Our last dependence on an allocator.
-
-  int remaining_attempts = kMaxDestructorIterations;
+// Runs the destructor of every slot in [min_slot, max_slot] that has a value
+// in |tls_data|, highest slot first, until no such slot has a value.
+void CallDestructors(TlsVector* tls_data,
+                     int min_slot,
+                     int max_slot,
+                     int* remaining_attempts) {
   bool need_to_scan_destructors = true;
   while (need_to_scan_destructors) {
     need_to_scan_destructors = false;
@@ -142,18 +293,32 @@ void OnThreadExitInternal(void* value) {
     // allocator) and should also be destroyed last.  If we get the order wrong,
     // then we'll itterate several more times, so it is really not that
     // critical (but it might help).
-    base::subtle::Atomic32 last_used_tls_key =
-        base::subtle::NoBarrier_Load(&g_last_used_tls_key);
-    for (int slot = last_used_tls_key; slot > 0; --slot) {
-      void* tls_value = stack_allocated_tls_data[slot];
+    for (int slot = max_slot; slot >= min_slot; --slot) {
+      TlsEntry* entry = GetSlotEntry(tls_data, slot);
+      if (entry == NULL) {
+        // Skip the rest of this unallocated chunk.
+        int offset;
+        ChunkForSlot(slot, &offset);
+        slot -= offset;
+        continue;
+      }
+      void* tls_value = entry->value;
       if (tls_value == NULL)
         continue;
 
+      // The destructor is loaded before the generation is checked. Free()
+      // clears the destructor before advancing the generation, and a new owner
+      // only installs its destructor after that, so a destructor that belongs
+      // to a new owner is never paired with a value from an old one.
+      SlotInfo* info = GetSlotInfo(slot);
       base::ThreadLocalStorage::TLSDestructorFunc destructor =
-          g_tls_destructors[slot];
-      if (destructor == NULL)
+          info ? info->destructor.load(std::memory_order_acquire) : NULL;
+      if (destructor == NULL ||
+          entry->generation !=
+              info->generation.load(std::memory_order_acquire)) {
         continue;
-      stack_allocated_tls_data[slot] = NULL;  // pre-clear the slot.
+      }
+      entry->value = NULL;  // pre-clear the slot.
       destructor(tls_value);
       // Any destructor might have called a different service, which then set
       // a different slot to a non-NULL value.  Hence we need to check
@@ -161,11 +326,57 @@ void OnThreadExitInternal(void* value) {
       need_to_scan_destructors = true;
     }
     // Destructors might not have been called.
-    CHECK_GT(--remaining_attempts, 0);
+    CHECK_GT(--*remaining_attempts, 0);
   }
+}
+
+bool HasChunks(const TlsVector* tls_data) {
+  for (TlsEntry* values : tls_data->chunks) {
+    if (values)
+      return true;
+  }
+  return false;
+}
+
+void OnThreadExitInternal(void* value) {
+  DCHECK(value);
+  TlsVector* tls_data = static_cast<TlsVector*>(value);
+  // Some allocators, such as TCMalloc, use TLS.  As a result, when a thread
+  // terminates, one of the destructor calls we make may be to shut down an
+  // allocator.  We have to be careful that after we've shutdown all of the
+  // known destructors (perchance including an allocator), that we don't call
+  // the allocator and cause it to resurrect itself (with no possibly destructor
+  // call to follow).  We handle this problem as follows:
+  // Switch to using a stack allocated vector, so that we don't have dependence
+  // on our allocator after we have called all destructors for inline slots.
+  // (i.e., don't even call delete[] after we're done with destructors.)
+  TlsVector stack_allocated_tls_data;
+  memcpy(&stack_allocated_tls_data, tls_data, sizeof(stack_allocated_tls_data));
+  // Ensure that any re-entrant calls change the temp version.
+  PlatformThreadLocalStorage::TLSKey key =
+      g_native_tls_key.load(std::memory_order_relaxed);
+  SetTlsVector(key, &stack_allocated_tls_data);
+  delete tls_data;
+
+  int remaining_attempts = kMaxDestructorIterations;
+  do {
+    // Slots stored in chunks were allocated after all inline slots, so they
+    // are destroyed first, and their chunks freed while the services behind
+    // the inline slots are still alive. Only then are the inline slots
+    // destroyed, after which there is no further dependence on an allocator
+    // unless one of those destructors stores into a chunked slot again.
+    CallDestructors(&stack_allocated_tls_data, kInlineSlots,
+                    g_last_used_tls_key.Load(), &remaining_attempts);
+    for (TlsEntry*& values : stack_allocated_tls_data.chunks) {
+      delete[] values;
+      values = NULL;
+    }
+    CallDestructors(&stack_allocated_tls_data, 1, kInlineSlots - 1,
+                    &remaining_attempts);
+  } while (HasChunks(&stack_allocated_tls_data));
 
   // Remove our stack allocated vector.
-  PlatformThreadLocalStorage::SetTLSValue(key, NULL);
+  SetTlsVector(key, NULL);
 }
 
 }  // namespace
@@ -177,7 +388,7 @@ namespace internal {
 #if BUILDFLAG(IS_WIN)
 void PlatformThreadLocalStorage::OnThreadExit() {
   PlatformThreadLocalStorage::TLSKey key =
-      base::subtle::NoBarrier_Load(&g_native_tls_key);
+      g_native_tls_key.load(std::memory_order_relaxed);
   if (key == PlatformThreadLocalStorage::TLS_KEY_OUT_OF_INDEXES)
     return;
   void *tls_data = GetTLSValue(key);
@@ -197,56 +408,65 @@ void PlatformThreadLocalStorage::OnThreadExit(void* value) {
 ThreadLocalStorage::Slot::Slot(TLSDestructorFunc destructor) {
   initialized_ = false;
   slot_ = 0;
+  generation_ = 0;
   Initialize(destructor);
 }
 
+ThreadLocalStorage::Slot::~Slot() {
+  if (initialized_)
+    Free();
+}
+
 void ThreadLocalStorage::StaticSlot::Initialize(TLSDestructorFunc destructor) {
-  PlatformThreadLocalStorage::TLSKey key =
-      base::subtle::NoBarrier_Load(&g_native_tls_key);
-  if (key == PlatformThreadLocalStorage::TLS_KEY_OUT_OF_INDEXES ||
-      !PlatformThreadLocalStorage::GetTLSValue(key))
+  if (!t_tls_vector)
     ConstructTlsVector();
 
-  // Grab a new slot.
-  slot_ = base::subtle::NoBarrier_AtomicIncrement(&g_last_used_tls_key, 1);
-  DCHECK_GT(slot_, 0);
-  CHECK_LT(slot_, kThreadLocalStorageSize);
+  // Grab a new slot, preferring one that has been freed.
+  slot_ = PopFreeSlot();
+  if (!slot_)
+    slot_ = g_last_used_tls_key.Increment();
+  CHECK_GT(slot_, 0);
 
   // Setup our destructor.
-  g_tls_destructors[slot_] = destructor;
+  SlotInfo* info = EnsureSlotInfo(slot_);
+  generation_ = info->generation.load(std::memory_order_acquire);
+  info->destructor.store(destructor, std::memory_order_release);
   initialized_ = true;
 }
 
 void ThreadLocalStorage::StaticSlot::Free() {
-  // At this time, we don't reclaim old indices for TLS slots.
-  // So all we need to do is wipe the destructor.
+  // Wipe the destructor so that remaining threads exiting will not free data,
+  // and advance the generation so that values stored through this slot read
+  // as null once it is reused.
   DCHECK_GT(slot_, 0);
-  DCHECK_LT(slot_, kThreadLocalStorageSize);
-  g_tls_destructors[slot_] = NULL;
+  SlotInfo* info = GetSlotInfo(slot_);
+  info->destructor.store(NULL, std::memory_order_relaxed);
+  info->generation.fetch_add(1, std::memory_order_release);
+  PushFreeSlot(slot_);
   slot_ = 0;
   initialized_ = false;
 }
 
 void* ThreadLocalStorage::StaticSlot::Get() const {
-  void** tls_data = static_cast<void**>(
-      PlatformThreadLocalStorage::GetTLSValue(
-          base::subtle::NoBarrier_Load(&g_native_tls_key)));
+  TlsVector* tls_data = t_tls_vector;
   if (!tls_data)
     tls_data = ConstructTlsVector();
   DCHECK_GT(slot_, 0);
-  DCHECK_LT(slot_, kThreadLocalStorageSize);
-  return tls_data[slot_];
+  TlsEntry* entry = GetSlotEntry(tls_data, slot_);
+  if (!entry || entry->generation != generation_)
+    return NULL;
+  return entry->value;
 }
 
 void ThreadLocalStorage::StaticSlot::Set(void* value) {
-  void** tls_data = static_cast<void**>(
-      PlatformThreadLocalStorage::GetTLSValue(
-          base::subtle::NoBarrier_Load(&g_native_tls_key)));
+  TlsVector* tls_data = t_tls_vector;
   if (!tls_data)
     tls_data = ConstructTlsVector();
   DCHECK_GT(slot_, 0);
-  DCHECK_LT(slot_, kThreadLocalStorageSize);
-  tls_data[slot_] = value;
+  TlsEntry* entry = slot_ < kInlineSlots ? &tls_data->inline_slots[slot_]
+                                         : EnsureSlotEntry(slot_);
+  entry->value = value;
+  entry->generation = generation_;
 }
 
 }  // namespace base
@@ -5,6 +5,8 @@
 #ifndef MINI_CHROMIUM_BASE_THREADING_THREAD_LOCAL_STORAGE_H_
 #define MINI_CHROMIUM_BASE_THREADING_THREAD_LOCAL_STORAGE_H_
 
+#include <stdint.h>
+
 #include "build/build_config.h"
 
 #if BUILDFLAG(IS_WIN)
@@ -101,7 +103,9 @@ class ThreadLocalStorage {
     // Free a previously allocated TLS 'slot'.
     // If a destructor was set for this slot, removes
     // the destructor so that remaining threads exiting
-    // will not free data.
+    // will not free data. The slot may then be reused by
+    // a later Initialize(), which will not observe any
+    // values stored through this one.
     void Free();
 
     // Get the thread-local value stored in slot 'slot'.
@@ -117,6 +121,7 @@ class ThreadLocalStorage {
     // The internals of this struct should be considered private.
     bool initialized_;
     int slot_;
+    uint32_t generation_;
   };
 
   ThreadLocalStorage(const ThreadLocalStorage&) = delete;
@@ -132,7 +137,11 @@ class ThreadLocalStorage {
     Slot(const Slot&) = delete;
     Slot& operator=(const Slot&) = delete;
 
+    // Calls StaticSlot::Free() if the slot is still initialized.
+    ~Slot();
+
    private:
+    using StaticSlot::generation_;
     using StaticSlot::initialized_;
     using StaticSlot::slot_;
   };